@@ -0,0 +1,379 @@
+#ifndef ARMAZEM_DISTANCIAS_HPP
+#define ARMAZEM_DISTANCIAS_HPP
+
+// Matriz de distâncias entre todos os pares (saída do fw) num layout em blocos,
+// na memória ou num arquivo .apsp mapeado, com tipo de elemento selecionável:
+//   float64: exato (padrão);
+//   float32: metade da memória, ~7 dígitos significativos;
+//   uint32:  pesos inteiros não negativos, com UINT32_MAX como infinito.
+//
+// A matriz é cortada em blocos de BLOCO_APSP x BLOCO_APSP, cada um contíguo (linhas
+// do bloco em sequência) e os blocos em ordem de linha. n é completado até múltiplo
+// do bloco com infinito. Assim o kernel do FW percorre páginas inteiras, e com o
+// arquivo mapeado o kernel traz para a RAM só os blocos que está usando.
+//
+// Layout do .apsp (inteiros na ordem de bytes nativa):
+//   CabecalhoAPSP
+//   int32 vertices[n]     vértice (id do .net) de cada linha/coluna
+//   blocos, a partir de posDados (alinhado em 4096)
+//
+// Quem só consome o resultado abre o arquivo com ArmazemDistancias(caminho) e lê
+// linhas sob demanda com lerLinha(), sem carregar a matriz inteira.
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// 64 x 64 doubles = 32 KiB por bloco: três blocos (C, A, B) cabem na L2
+const int BLOCO_APSP = 64;
+
+const std::uint32_t APSP_VERSAO = 1;
+
+enum class TipoDistancia : std::uint32_t { FLOAT64 = 0, FLOAT32 = 1, UINT32 = 2 };
+
+inline const char* nomeTipoDistancia(TipoDistancia tipo) {
+    switch (tipo) {
+        case TipoDistancia::FLOAT32: return "float32";
+        case TipoDistancia::UINT32: return "uint32";
+        default: return "float64";
+    }
+}
+
+// "float64", "float32" ou "uint32"; false para outro nome
+inline bool tipoDistanciaPorNome(const std::string& nome, TipoDistancia& tipo) {
+    if (nome == "float64") tipo = TipoDistancia::FLOAT64;
+    else if (nome == "float32") tipo = TipoDistancia::FLOAT32;
+    else if (nome == "uint32") tipo = TipoDistancia::UINT32;
+    else return false;
+    return true;
+}
+
+inline std::size_t bytesElemento(TipoDistancia tipo) {
+    return tipo == TipoDistancia::FLOAT64 ? 8 : 4;
+}
+
+// Conversões entre o tipo guardado e double (infinito <-> infinito)
+template <typename T>
+struct ElementoDistancia;
+
+template <>
+struct ElementoDistancia<double> {
+    static constexpr TipoDistancia tipo = TipoDistancia::FLOAT64;
+    static double infinito() { return std::numeric_limits<double>::infinity(); }
+    static double paraDouble(double x) { return x; }
+    static double deDouble(double x) { return x; }
+};
+
+template <>
+struct ElementoDistancia<float> {
+    static constexpr TipoDistancia tipo = TipoDistancia::FLOAT32;
+    static float infinito() { return std::numeric_limits<float>::infinity(); }
+    static double paraDouble(float x) { return x; }
+    static float deDouble(double x) { return static_cast<float>(x); }
+};
+
+template <>
+struct ElementoDistancia<std::uint32_t> {
+    static constexpr TipoDistancia tipo = TipoDistancia::UINT32;
+    static constexpr std::uint32_t INFINITO = std::numeric_limits<std::uint32_t>::max();
+    static std::uint32_t infinito() { return INFINITO; }
+    static double paraDouble(std::uint32_t x) {
+        return x == INFINITO ? std::numeric_limits<double>::infinity() : static_cast<double>(x);
+    }
+    static std::uint32_t deDouble(double x) {
+        return x >= static_cast<double>(INFINITO) ? INFINITO : static_cast<std::uint32_t>(x);
+    }
+};
+
+struct CabecalhoAPSP {
+    char magica[4];
+    std::uint32_t versao;
+    std::uint32_t tipo;            // TipoDistancia
+    std::uint32_t bloco;           // BLOCO_APSP de quem gravou
+    std::uint64_t numVertices;
+    std::uint64_t numBlocos;       // blocos por lado
+    std::uint64_t posVertices;
+    std::uint64_t posDados;
+    std::uint64_t tamanhoArquivo;
+};
+
+class ArmazemDistancias {
+private:
+    struct Liberar {
+        void operator()(unsigned char* p) const { std::free(p); }
+    };
+
+    TipoDistancia tipo_ = TipoDistancia::FLOAT64;
+    int n = 0;
+    int blocos = 0;
+    std::vector<int> vertices_;
+    unsigned char* dados = nullptr;
+    std::unique_ptr<unsigned char[], Liberar> memoria;
+    void* mapa = nullptr;
+    std::size_t bytesMapa = 0;
+    std::string caminho;
+    bool gravavel = false;
+    bool ok = false;
+
+    std::size_t bytesBloco() const {
+        return static_cast<std::size_t>(BLOCO_APSP) * BLOCO_APSP * bytesElemento(tipo_);
+    }
+
+    std::size_t bytesDados() const {
+        return static_cast<std::size_t>(blocos) * blocos * bytesBloco();
+    }
+
+    static std::uint64_t alinharPagina(std::uint64_t pos) {
+        return (pos + 4095) & ~std::uint64_t(4095);
+    }
+
+    // Posição de (i, j) em elementos, a partir do início dos dados
+    std::size_t posicao(int i, int j) const {
+        std::size_t b = static_cast<std::size_t>(i / BLOCO_APSP) * blocos + j / BLOCO_APSP;
+        return b * BLOCO_APSP * BLOCO_APSP + (i % BLOCO_APSP) * BLOCO_APSP + j % BLOCO_APSP;
+    }
+
+    template <typename T>
+    void preencherInfinito() {
+        T* p = reinterpret_cast<T*>(dados);
+        std::fill(p, p + bytesDados() / sizeof(T), ElementoDistancia<T>::infinito());
+    }
+
+    template <typename T>
+    void lerLinhaTipada(int i, double* destino) const {
+        for (int bj = 0; bj < blocos; bj++) {
+            const T* linha = bloco<T>(i / BLOCO_APSP, bj) + (i % BLOCO_APSP) * BLOCO_APSP;
+            int largura = std::min(BLOCO_APSP, n - bj * BLOCO_APSP);
+            for (int j = 0; j < largura; j++) {
+                destino[bj * BLOCO_APSP + j] = ElementoDistancia<T>::paraDouble(linha[j]);
+            }
+        }
+    }
+
+    template <typename T>
+    void escreverLinhaTipada(int i, const double* origem) {
+        for (int bj = 0; bj < blocos; bj++) {
+            T* linha = bloco<T>(i / BLOCO_APSP, bj) + (i % BLOCO_APSP) * BLOCO_APSP;
+            int largura = std::min(BLOCO_APSP, n - bj * BLOCO_APSP);
+            for (int j = 0; j < largura; j++) {
+                linha[j] = ElementoDistancia<T>::deDouble(origem[bj * BLOCO_APSP + j]);
+            }
+        }
+    }
+
+#ifndef _WIN32
+    // Mapeia o arquivo inteiro; escrita = MAP_SHARED de leitura e escrita
+    bool mapear(int fd, std::size_t bytes, bool escrita) {
+        int protecao = escrita ? PROT_READ | PROT_WRITE : PROT_READ;
+        void* base = ::mmap(nullptr, bytes, protecao, MAP_SHARED, fd, 0);
+        if (base == MAP_FAILED) return false;
+        mapa = base;
+        bytesMapa = bytes;
+        return true;
+    }
+#endif
+
+    CabecalhoAPSP cabecalho() const {
+        CabecalhoAPSP cab;
+        std::memset(&cab, 0, sizeof(cab));
+        std::memcpy(cab.magica, "APSP", 4);
+        cab.versao = APSP_VERSAO;
+        cab.tipo = static_cast<std::uint32_t>(tipo_);
+        cab.bloco = BLOCO_APSP;
+        cab.numVertices = n;
+        cab.numBlocos = blocos;
+        cab.posVertices = sizeof(CabecalhoAPSP);
+        cab.posDados = alinharPagina(cab.posVertices + static_cast<std::uint64_t>(n) * sizeof(std::int32_t));
+        cab.tamanhoArquivo = cab.posDados + bytesDados();
+        return cab;
+    }
+
+public:
+    // Matriz nova, toda infinita. Com caminho não vazio ela vive no arquivo (criado ou
+    // truncado) mapeado em memória; senão, numa alocação alinhada em 64 bytes.
+    ArmazemDistancias(TipoDistancia tipo, const std::vector<int>& vertices, const std::string& arquivo = "")
+        : tipo_(tipo), n(vertices.size()), blocos((n + BLOCO_APSP - 1) / BLOCO_APSP), vertices_(vertices),
+          caminho(arquivo), gravavel(true) {
+        if (caminho.empty()) {
+            std::size_t bytes = std::max<std::size_t>(64, bytesDados());
+            memoria.reset(static_cast<unsigned char*>(std::aligned_alloc(64, (bytes + 63) & ~std::size_t(63))));
+            if (!memoria) throw std::bad_alloc();
+            dados = memoria.get();
+        } else {
+            CabecalhoAPSP cab = cabecalho();
+#ifdef _WIN32
+            // Sem mmap gravável: a matriz fica na memória e vai para o arquivo em sincronizar()
+            memoria.reset(static_cast<unsigned char*>(std::malloc(cab.tamanhoArquivo)));
+            if (!memoria) throw std::bad_alloc();
+            std::memset(memoria.get(), 0, cab.posDados);
+            std::memcpy(memoria.get(), &cab, sizeof(cab));
+            dados = memoria.get() + cab.posDados;
+#else
+            int fd = ::open(caminho.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) {
+                std::cerr << "Erro ao criar arquivo: " << caminho << std::endl;
+                return;
+            }
+            bool mapeado = ::ftruncate(fd, static_cast<off_t>(cab.tamanhoArquivo)) == 0 &&
+                           mapear(fd, cab.tamanhoArquivo, true);
+            ::close(fd);
+            if (!mapeado) {
+                std::cerr << "Erro ao mapear arquivo: " << caminho << std::endl;
+                return;
+            }
+            std::memcpy(mapa, &cab, sizeof(cab));
+            dados = static_cast<unsigned char*>(mapa) + cab.posDados;
+#endif
+            std::int32_t* ids = reinterpret_cast<std::int32_t*>(dados - cab.posDados + cab.posVertices);
+            for (int i = 0; i < n; i++) ids[i] = vertices_[i];
+        }
+        switch (tipo_) {
+            case TipoDistancia::FLOAT32: preencherInfinito<float>(); break;
+            case TipoDistancia::UINT32: preencherInfinito<std::uint32_t>(); break;
+            default: preencherInfinito<double>(); break;
+        }
+        ok = true;
+    }
+
+    // Abre um .apsp gravado antes, somente leitura (as páginas vêm do disco sob demanda)
+    explicit ArmazemDistancias(const std::string& arquivo) : caminho(arquivo) {
+#ifdef _WIN32
+        std::ifstream entrada(caminho, std::ios::binary);
+        CabecalhoAPSP cab;
+        if (!entrada.read(reinterpret_cast<char*>(&cab), sizeof(cab))) return;
+        memoria.reset(static_cast<unsigned char*>(std::malloc(cab.tamanhoArquivo)));
+        if (!memoria) return;
+        entrada.seekg(0);
+        if (!entrada.read(reinterpret_cast<char*>(memoria.get()), cab.tamanhoArquivo)) return;
+        const unsigned char* base = memoria.get();
+        std::size_t tamanho = cab.tamanhoArquivo;
+#else
+        int fd = ::open(caminho.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        bool mapeado = ::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= sizeof(CabecalhoAPSP) &&
+                       mapear(fd, static_cast<std::size_t>(info.st_size), false);
+        ::close(fd);
+        if (!mapeado) return;
+        const unsigned char* base = static_cast<const unsigned char*>(mapa);
+        std::size_t tamanho = bytesMapa;
+#endif
+        CabecalhoAPSP cab;
+        std::memcpy(&cab, base, sizeof(cab));
+        if (std::memcmp(cab.magica, "APSP", 4) != 0 || cab.versao != APSP_VERSAO) return;
+        if (cab.bloco != static_cast<std::uint32_t>(BLOCO_APSP) || cab.tipo > 2) return;
+        if (cab.numVertices > static_cast<std::uint64_t>(std::numeric_limits<int>::max())) return;
+        tipo_ = static_cast<TipoDistancia>(cab.tipo);
+        n = static_cast<int>(cab.numVertices);
+        blocos = static_cast<int>(cab.numBlocos);
+        if (blocos != (n + BLOCO_APSP - 1) / BLOCO_APSP) return;
+        if (cab.tamanhoArquivo != tamanho || cabecalho().posDados != cab.posDados ||
+            cab.posDados + bytesDados() != tamanho) {
+            return;
+        }
+        // Ids dos vértices logo após o cabeçalho (onde cabecalho() os põe) e antes dos dados
+        if (cab.posVertices != sizeof(CabecalhoAPSP) ||
+            cab.posVertices + static_cast<std::uint64_t>(n) * sizeof(std::int32_t) > cab.posDados) {
+            return;
+        }
+        const std::int32_t* ids = reinterpret_cast<const std::int32_t*>(base + cab.posVertices);
+        vertices_.assign(ids, ids + n);
+        dados = const_cast<unsigned char*>(base) + cab.posDados;
+        ok = true;
+    }
+
+    ~ArmazemDistancias() {
+#ifndef _WIN32
+        if (mapa != nullptr) ::munmap(mapa, bytesMapa);
+#else
+        sincronizar();
+#endif
+    }
+
+    ArmazemDistancias(const ArmazemDistancias&) = delete;
+    ArmazemDistancias& operator=(const ArmazemDistancias&) = delete;
+
+    bool valido() const { return ok; }
+    TipoDistancia tipo() const { return tipo_; }
+    int tamanho() const { return n; }
+    int numBlocos() const { return blocos; }
+    bool emArquivo() const { return !caminho.empty(); }
+    // vertices()[i] é o vértice da linha/coluna i
+    const std::vector<int>& vertices() const { return vertices_; }
+
+    // Bloco (bi, bj): BLOCO_APSP linhas de BLOCO_APSP elementos, em sequência.
+    // T tem que corresponder a tipo().
+    template <typename T>
+    T* bloco(int bi, int bj) {
+        return reinterpret_cast<T*>(dados) + (static_cast<std::size_t>(bi) * blocos + bj) * BLOCO_APSP * BLOCO_APSP;
+    }
+
+    template <typename T>
+    const T* bloco(int bi, int bj) const {
+        return reinterpret_cast<const T*>(dados) +
+               (static_cast<std::size_t>(bi) * blocos + bj) * BLOCO_APSP * BLOCO_APSP;
+    }
+
+    template <typename T>
+    T& em(int i, int j) {
+        return reinterpret_cast<T*>(dados)[posicao(i, j)];
+    }
+
+    double valor(int i, int j) const {
+        switch (tipo_) {
+            case TipoDistancia::FLOAT32:
+                return ElementoDistancia<float>::paraDouble(reinterpret_cast<const float*>(dados)[posicao(i, j)]);
+            case TipoDistancia::UINT32:
+                return ElementoDistancia<std::uint32_t>::paraDouble(
+                    reinterpret_cast<const std::uint32_t*>(dados)[posicao(i, j)]);
+            default:
+                return reinterpret_cast<const double*>(dados)[posicao(i, j)];
+        }
+    }
+
+    // Linha i convertida para double em destino[0..n), tocando só os blocos dessa faixa
+    void lerLinha(int i, double* destino) const {
+        switch (tipo_) {
+            case TipoDistancia::FLOAT32: lerLinhaTipada<float>(i, destino); break;
+            case TipoDistancia::UINT32: lerLinhaTipada<std::uint32_t>(i, destino); break;
+            default: lerLinhaTipada<double>(i, destino); break;
+        }
+    }
+
+    void escreverLinha(int i, const double* origem) {
+        switch (tipo_) {
+            case TipoDistancia::FLOAT32: escreverLinhaTipada<float>(i, origem); break;
+            case TipoDistancia::UINT32: escreverLinhaTipada<std::uint32_t>(i, origem); break;
+            default: escreverLinhaTipada<double>(i, origem); break;
+        }
+    }
+
+    // Garante que o arquivo no disco está completo (sem efeito na memória)
+    void sincronizar() {
+#ifdef _WIN32
+        if (!caminho.empty() && gravavel && ok) {
+            std::ofstream saida(caminho, std::ios::binary | std::ios::trunc);
+            saida.write(reinterpret_cast<const char*>(memoria.get()), cabecalho().tamanhoArquivo);
+        }
+#else
+        if (mapa != nullptr && gravavel) ::msync(mapa, bytesMapa, MS_SYNC);
+#endif
+    }
+};
+
+#endif
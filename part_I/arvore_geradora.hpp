@@ -0,0 +1,413 @@
+#ifndef ARVORE_GERADORA_HPP
+#define ARVORE_GERADORA_HPP
+
+// Motor de árvore geradora mínima compartilhado pelos Kruskal das partes I e II.
+//
+// Filter-Kruskal: em vez de ordenar todas as arestas, a faixa é particionada em torno
+// de um pivô; a metade leve é resolvida primeiro e, antes de mexer na pesada, dela se
+// descartam as arestas cujas pontas já estão na mesma componente. Em grafos densos a
+// maior parte das arestas nunca entra na árvore e assim nunca chega a ser ordenada.
+// Faixas pequenas (até ~V arestas) são ordenadas (radix LSD paralelo sobre registros
+// de 16 bytes) e varridas como no Kruskal comum.
+//
+// Borůvka (arvoreGeradoraBoruvka): rodadas em que cada componente escolhe a sua aresta
+// de saída mínima em paralelo, as componentes são ligadas num union-find sem travas e
+// as arestas internas são descartadas. Serve para os grafos em que o Kruskal, sequencial
+// depois da ordenação, é o gargalo.
+//
+// Empates são desfeitos por (peso, u, v): as arestas aceitas e a ordem em que saem
+// são as de um Kruskal que ordena as tuplas (peso, u, v).
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include "paralelo.hpp"
+
+// Faixas com até max(MST_FAIXA_MINIMA, V) arestas vão direto para ordenação
+const std::size_t MST_FAIXA_MINIMA = 1024;
+// Abaixo disso std::sort; acima, radix
+const std::size_t MST_LIMIAR_RADIX = 1 << 15;
+// Arestas por thread abaixo das quais não vale abrir threads
+const std::size_t MST_ARESTAS_POR_THREAD = 1 << 14;
+
+struct ArestaMST {
+    double peso;
+    std::uint32_t u, v;
+};
+
+static_assert(sizeof(ArestaMST) == 16, "registro de aresta empacotado em 16 bytes");
+
+// Union-find com união por tamanho e busca iterativa com path halving
+// (sem recursão: não estoura a pilha em cadeias longas)
+class UniaoBusca {
+private:
+    std::vector<std::uint32_t> pai;
+    std::vector<std::uint32_t> tamanho;
+
+public:
+    explicit UniaoBusca(std::size_t n) : pai(n), tamanho(n, 1) {
+        for (std::size_t i = 0; i < n; i++) pai[i] = static_cast<std::uint32_t>(i);
+    }
+
+    std::uint32_t raiz(std::uint32_t x) {
+        while (pai[x] != x) {
+            pai[x] = pai[pai[x]];
+            x = pai[x];
+        }
+        return x;
+    }
+
+    // Sem escrever em pai: pode ser chamada por várias threads ao mesmo tempo
+    std::uint32_t raizSemCompressao(std::uint32_t x) const {
+        while (pai[x] != x) x = pai[x];
+        return x;
+    }
+
+    bool unir(std::uint32_t x, std::uint32_t y) {
+        x = raiz(x);
+        y = raiz(y);
+        if (x == y) return false;
+        if (tamanho[x] < tamanho[y]) std::swap(x, y);
+        pai[y] = x;
+        tamanho[x] += tamanho[y];
+        return true;
+    }
+};
+
+// Union-find sem travas para as ligações concorrentes do Borůvka. A raiz de maior id
+// passa a apontar para a de menor id (compare-and-swap), o que impede ciclos; a busca
+// faz path halving também com CAS, e um CAS perdido só deixa de encurtar o caminho.
+class UniaoBuscaAtomica {
+private:
+    std::unique_ptr<std::atomic<std::uint32_t>[]> pai;
+
+public:
+    explicit UniaoBuscaAtomica(std::size_t n) : pai(new std::atomic<std::uint32_t>[n]) {
+        for (std::size_t i = 0; i < n; i++) pai[i].store(static_cast<std::uint32_t>(i), std::memory_order_relaxed);
+    }
+
+    std::uint32_t raiz(std::uint32_t x) {
+        while (true) {
+            std::uint32_t p = pai[x].load(std::memory_order_acquire);
+            if (p == x) return x;
+            std::uint32_t avo = pai[p].load(std::memory_order_acquire);
+            if (p != avo) pai[x].compare_exchange_weak(p, avo, std::memory_order_release, std::memory_order_relaxed);
+            x = avo;
+        }
+    }
+
+    bool unir(std::uint32_t x, std::uint32_t y) {
+        while (true) {
+            x = raiz(x);
+            y = raiz(y);
+            if (x == y) return false;
+            if (x < y) std::swap(x, y);
+            std::uint32_t esperado = x;
+            if (pai[x].compare_exchange_strong(esperado, y, std::memory_order_acq_rel)) return true;
+        }
+    }
+};
+
+// Uma rodada do Borůvka
+struct RodadaMST {
+    std::size_t arestas = 0;           // arestas entre componentes no início da rodada
+    std::size_t unioes = 0;            // arestas que entraram na árvore
+    double segundos = 0.0;
+};
+
+struct ResultadoMST {
+    double pesoTotal = 0.0;
+    std::vector<ArestaMST> arestas;    // em ordem crescente de (peso, u, v)
+    std::size_t ordenadas = 0;         // arestas que passaram por uma ordenação
+    std::size_t descartadas = 0;       // removidas pelo filtro antes de ordenar
+    std::size_t particoes = 0;
+    std::vector<RodadaMST> rodadas;    // só no Borůvka
+    unsigned threads = 1;
+    double segundos = 0.0;
+};
+
+namespace mst_detalhe {
+
+inline bool menor(const ArestaMST& a, const ArestaMST& b) {
+    if (a.peso != b.peso) return a.peso < b.peso;
+    if (a.u != b.u) return a.u < b.u;
+    return a.v < b.v;
+}
+
+// Bits do double numa ordem que o radix respeita (negativos invertidos)
+inline std::uint64_t chavePeso(double peso) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &peso, sizeof bits);
+    return (bits >> 63) ? ~bits : bits | (std::uint64_t(1) << 63);
+}
+
+// Dígito d (byte) da chave de 16 bytes (peso, u, v), do menos significativo
+inline unsigned digito(const ArestaMST& a, int d) {
+    if (d < 4) return (a.v >> (8 * d)) & 255;
+    if (d < 8) return (a.u >> (8 * (d - 4))) & 255;
+    return static_cast<unsigned>(chavePeso(a.peso) >> (8 * (d - 8))) & 255;
+}
+
+inline unsigned threadsPara(std::size_t n, unsigned threads) {
+    return static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(threads, n / MST_ARESTAS_POR_THREAD)));
+}
+
+// Radix LSD estável, um byte por passada. Passadas cujo byte é igual em todas as
+// arestas (ids pequenos, pesos inteiros com mantissa baixa zerada) são puladas.
+// Cada thread conta e espalha a sua fatia; os deslocamentos por (balde, thread)
+// preservam a ordem entre fatias.
+inline void ordenarRadix(ArestaMST* dados, ArestaMST* auxiliar, std::size_t n, unsigned threads) {
+    threads = threadsPara(n, threads);
+    std::vector<std::uint64_t> ou(threads * 3, 0), e(threads * 3, ~std::uint64_t(0));
+    emParalelo(threads, [&](unsigned id) {
+        std::uint64_t* o = &ou[id * 3];
+        std::uint64_t* a = &e[id * 3];
+        for (std::size_t i = n * id / threads; i < n * (id + 1) / threads; i++) {
+            std::uint64_t c = chavePeso(dados[i].peso);
+            o[0] |= dados[i].v; a[0] &= dados[i].v;
+            o[1] |= dados[i].u; a[1] &= dados[i].u;
+            o[2] |= c;          a[2] &= c;
+        }
+    });
+    std::vector<int> passadas;
+    for (int d = 0; d < 16; d++) {
+        int campo = d < 4 ? 0 : d < 8 ? 1 : 2;
+        int deslocamento = 8 * (d < 4 ? d : d < 8 ? d - 4 : d - 8);
+        std::uint64_t oTotal = 0, eTotal = ~std::uint64_t(0);
+        for (unsigned t = 0; t < threads; t++) {
+            oTotal |= ou[t * 3 + campo];
+            eTotal &= e[t * 3 + campo];
+        }
+        if ((oTotal ^ eTotal) >> deslocamento & 255) passadas.push_back(d);
+    }
+    if (passadas.empty()) return;
+
+    std::vector<std::size_t> contagem(threads * 256);
+    Barreira barreira(threads);
+    emParalelo(threads, [&](unsigned id) {
+        ArestaMST* origem = dados;
+        ArestaMST* destino = auxiliar;
+        std::size_t inicio = n * id / threads, fim = n * (id + 1) / threads;
+        std::size_t* minha = &contagem[id * 256];
+        for (int d : passadas) {
+            std::fill(minha, minha + 256, 0);
+            for (std::size_t i = inicio; i < fim; i++) minha[digito(origem[i], d)]++;
+            barreira.esperar();
+            if (id == 0) {
+                std::size_t soma = 0;
+                for (int b = 0; b < 256; b++) {
+                    for (unsigned t = 0; t < threads; t++) {
+                        std::size_t c = contagem[t * 256 + b];
+                        contagem[t * 256 + b] = soma;
+                        soma += c;
+                    }
+                }
+            }
+            barreira.esperar();
+            for (std::size_t i = inicio; i < fim; i++) destino[minha[digito(origem[i], d)]++] = origem[i];
+            barreira.esperar();
+            std::swap(origem, destino);
+        }
+        // Número ímpar de passadas: o resultado ficou no auxiliar
+        if (origem != dados) std::copy(origem + inicio, origem + fim, dados + inicio);
+    });
+}
+
+// Mantém (na ordem) só as arestas com manter(aresta); devolve quantas ficaram
+template <typename F>
+std::size_t compactar(ArestaMST* dados, std::size_t n, unsigned threads, F manter) {
+    threads = threadsPara(n, threads);
+    if (threads == 1) {
+        return std::remove_if(dados, dados + n, [&](const ArestaMST& a) { return !manter(a); }) - dados;
+    }
+    // Cada thread compacta a própria fatia; depois as fatias são juntadas em ordem
+    std::vector<std::size_t> mantidas(threads);
+    emParalelo(threads, [&](unsigned id) {
+        std::size_t inicio = n * id / threads, fim = n * (id + 1) / threads;
+        std::size_t saida = inicio;
+        for (std::size_t i = inicio; i < fim; i++) {
+            if (manter(dados[i])) dados[saida++] = dados[i];
+        }
+        mantidas[id] = saida - inicio;
+    });
+    std::size_t total = mantidas[0];
+    for (unsigned t = 1; t < threads; t++) {
+        std::size_t inicio = n * t / threads;
+        std::memmove(static_cast<void*>(dados + total), dados + inicio, mantidas[t] * sizeof(ArestaMST));
+        total += mantidas[t];
+    }
+    return total;
+}
+
+// Só as arestas entre componentes diferentes do union-find
+inline std::size_t filtrar(ArestaMST* dados, std::size_t n, const UniaoBusca& componentes, unsigned threads) {
+    return compactar(dados, n, threads, [&](const ArestaMST& a) {
+        return componentes.raizSemCompressao(a.u) != componentes.raizSemCompressao(a.v);
+    });
+}
+
+} // namespace mst_detalhe
+
+// Árvore (floresta) geradora mínima das arestas dadas, com vértices 0..numVertices-1.
+// As arestas são reordenadas no lugar. numThreads = 0 usa todos os núcleos.
+inline ResultadoMST arvoreGeradoraMinima(std::size_t numVertices, std::vector<ArestaMST>& arestas,
+                                         unsigned numThreads = 0) {
+    auto inicioRelogio = std::chrono::steady_clock::now();
+    ResultadoMST r;
+    r.threads = threadsEfetivas(numThreads);
+    UniaoBusca componentes(numVertices);
+    ArestaMST* dados = arestas.data();
+
+    // -0.0 vira 0.0 para a chave do radix concordar com a comparação de doubles.
+    // Com as arestas de V' vértices tocados em uma componente, a árvore tem V' - 1
+    // arestas e a busca para assim que as tiver.
+    std::vector<char> tocado(numVertices, 0);
+    std::size_t tocados = 0;
+    for (auto& a : arestas) {
+        a.peso += 0.0;
+        if (!tocado[a.u]) { tocado[a.u] = 1; tocados++; }
+        if (!tocado[a.v]) { tocado[a.v] = 1; tocados++; }
+    }
+    std::size_t alvo = tocados > 0 ? tocados - 1 : 0;
+
+    struct Faixa {
+        std::size_t inicio, fim;
+        bool filtrar;
+    };
+    std::vector<Faixa> pendentes = {{0, arestas.size(), false}};
+    std::vector<ArestaMST> auxiliar;
+    std::size_t limiar = std::max(MST_FAIXA_MINIMA, numVertices);
+
+    while (!pendentes.empty() && r.arestas.size() < alvo) {
+        Faixa f = pendentes.back();
+        pendentes.pop_back();
+        if (f.filtrar) {
+            std::size_t restantes = mst_detalhe::filtrar(dados + f.inicio, f.fim - f.inicio, componentes, r.threads);
+            r.descartadas += f.fim - f.inicio - restantes;
+            f.fim = f.inicio + restantes;
+        }
+        std::size_t n = f.fim - f.inicio;
+        if (n == 0) continue;
+
+        if (n > limiar) {
+            // Pivô: mediana de uma amostra espaçada da faixa
+            std::vector<ArestaMST> amostra;
+            for (std::size_t i = 0; i < 63; i++) amostra.push_back(dados[f.inicio + n * i / 63]);
+            std::nth_element(amostra.begin(), amostra.begin() + 31, amostra.end(), mst_detalhe::menor);
+            ArestaMST pivo = amostra[31];
+            ArestaMST* meio = std::partition(dados + f.inicio, dados + f.fim,
+                                             [&](const ArestaMST& a) { return !mst_detalhe::menor(pivo, a); });
+            std::size_t corte = meio - dados;
+            // Faixa toda <= pivô (muitas arestas iguais): ordena de uma vez
+            if (corte < f.fim) {
+                r.particoes++;
+                pendentes.push_back({corte, f.fim, true});
+                pendentes.push_back({f.inicio, corte, false});
+                continue;
+            }
+        }
+
+        r.ordenadas += n;
+        if (n < MST_LIMIAR_RADIX) {
+            std::sort(dados + f.inicio, dados + f.fim, mst_detalhe::menor);
+        } else {
+            if (auxiliar.size() < n) auxiliar.resize(n);
+            mst_detalhe::ordenarRadix(dados + f.inicio, auxiliar.data(), n, r.threads);
+        }
+        for (std::size_t i = f.inicio; i < f.fim && r.arestas.size() < alvo; i++) {
+            if (componentes.unir(dados[i].u, dados[i].v)) {
+                r.pesoTotal += dados[i].peso;
+                r.arestas.push_back(dados[i]);
+            }
+        }
+    }
+
+    r.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicioRelogio).count();
+    return r;
+}
+
+// Mesma árvore de arvoreGeradoraMinima() (a ordem (peso, u, v) é total, então a árvore é
+// única), montada por rodadas de Borůvka. As arestas são compactadas no lugar.
+inline ResultadoMST arvoreGeradoraBoruvka(std::size_t numVertices, std::vector<ArestaMST>& arestas,
+                                          unsigned numThreads = 0) {
+    using relogio = std::chrono::steady_clock;
+    const std::uint64_t NENHUMA = ~std::uint64_t(0);
+    auto inicioRelogio = relogio::now();
+    ResultadoMST r;
+    r.threads = threadsEfetivas(numThreads);
+    const ArestaMST* dados = arestas.data();
+    for (auto& a : arestas) a.peso += 0.0;
+
+    // componente[v]: raiz de v no início da rodada; melhor[c]: índice da aresta mínima de c
+    std::vector<std::uint32_t> componente(numVertices);
+    for (std::size_t v = 0; v < numVertices; v++) componente[v] = static_cast<std::uint32_t>(v);
+    std::unique_ptr<std::atomic<std::uint64_t>[]> melhor(new std::atomic<std::uint64_t>[numVertices]);
+    for (std::size_t v = 0; v < numVertices; v++) melhor[v].store(NENHUMA, std::memory_order_relaxed);
+    UniaoBuscaAtomica ligacoes(numVertices);
+    auto propor = [&](std::uint32_t c, std::uint64_t i) {
+        std::uint64_t atual = melhor[c].load(std::memory_order_relaxed);
+        while ((atual == NENHUMA || mst_detalhe::menor(dados[i], dados[atual])) &&
+               !melhor[c].compare_exchange_weak(atual, i, std::memory_order_relaxed)) {
+        }
+    };
+
+    std::size_t m = mst_detalhe::compactar(arestas.data(), arestas.size(), r.threads,
+                                           [](const ArestaMST& a) { return a.u != a.v; });
+    std::vector<std::vector<ArestaMST>> escolhidas(r.threads);
+    while (m > 0) {
+        auto inicioRodada = relogio::now();
+        RodadaMST rodada;
+        rodada.arestas = m;
+        unsigned threads = mst_detalhe::threadsPara(std::max(m, numVertices), r.threads);
+
+        // 1. Aresta de saída mínima de cada componente
+        emParalelo(threads, [&](unsigned id) {
+            for (std::size_t i = m * id / threads; i < m * (id + 1) / threads; i++) {
+                propor(componente[dados[i].u], i);
+                propor(componente[dados[i].v], i);
+            }
+        });
+        // 2. Cada componente se liga pela sua aresta; se duas escolheram a mesma
+        //    (o único ciclo possível com ordem total), só a de menor id a adiciona
+        emParalelo(threads, [&](unsigned id) {
+            for (std::size_t c = numVertices * id / threads; c < numVertices * (id + 1) / threads; c++) {
+                std::uint64_t i = melhor[c].load(std::memory_order_relaxed);
+                if (componente[c] != c || i == NENHUMA) continue;
+                std::uint32_t outro = componente[dados[i].u] == c ? componente[dados[i].v] : componente[dados[i].u];
+                if (outro < c && melhor[outro].load(std::memory_order_relaxed) == i) continue;
+                ligacoes.unir(static_cast<std::uint32_t>(c), outro);
+                escolhidas[id].push_back(dados[i]);
+            }
+        });
+        // 3. Contração: novas raízes, e só as arestas entre componentes diferentes
+        emParalelo(threads, [&](unsigned id) {
+            for (std::size_t v = numVertices * id / threads; v < numVertices * (id + 1) / threads; v++) {
+                melhor[v].store(NENHUMA, std::memory_order_relaxed);
+                componente[v] = ligacoes.raiz(static_cast<std::uint32_t>(v));
+            }
+        });
+        m = mst_detalhe::compactar(arestas.data(), m, threads, [&](const ArestaMST& a) {
+            return componente[a.u] != componente[a.v];
+        });
+
+        for (auto& lista : escolhidas) {
+            rodada.unioes += lista.size();
+            r.arestas.insert(r.arestas.end(), lista.begin(), lista.end());
+            lista.clear();
+        }
+        rodada.segundos = std::chrono::duration<double>(relogio::now() - inicioRodada).count();
+        r.rodadas.push_back(rodada);
+    }
+
+    // Ordem (e soma) de saída iguais às do Kruskal
+    std::sort(r.arestas.begin(), r.arestas.end(), mst_detalhe::menor);
+    for (const auto& a : r.arestas) r.pesoTotal += a.peso;
+    r.segundos = std::chrono::duration<double>(relogio::now() - inicioRelogio).count();
+    return r;
+}
+
+#endif
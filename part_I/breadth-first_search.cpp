@@ -1,138 +1,74 @@
 #include <iostream>
-#include <queue>
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 #include <algorithm>
 #include "grafo.hpp"
+#include "busca_largura.hpp"
+#include "paralelo.hpp"
 
-std::unordered_map<int, std::vector<int>> buscaEmLargura(const Grafo& grafo, int s) {
-    std::unordered_set<int> visitado;
-    std::queue<std::pair<int, int>> fila; // {vertice, nivel}
-    std::unordered_map<int, std::vector<int>> niveis;
-#include <iostream>
-#include <queue>
-#include <unordered_map>
-#include <unordered_set>
-#include <vector>
-#include <algorithm>
-#include "grafo.hpp"
-
-std::unordered_map<int, std::vector<int>> buscaEmLargura(const Grafo& grafo, int s) {
-    std::unordered_set<int> visitado;
-    std::queue<std::pair<int, int>> fila; // {vertice, nivel}
-    std::unordered_map<int, std::vector<int>> niveis;
-    
-    fila.push({s, 0});
-    
-    while (!fila.empty()) {
-        auto [v, nivel] = fila.front();
-        fila.pop();
-        
-        if (visitado.find(v) != visitado.end()) {
-            continue;
-        }
-        
-        visitado.insert(v);
-        niveis[nivel].push_back(v);
-        
-        for (int vizinho : grafo.vizinhos(v)) {
-            if (visitado.find(vizinho) == visitado.end()) {
-                fila.push({vizinho, nivel + 1});
-            }
-        }
+// Com GRAFO_ESTATISTICAS: TEPS com 1, 2, 4, ... threads, para dimensionar máquinas
+void relatorioTEPS(const Grafo& grafo, int s, unsigned maxThreads) {
+    for (unsigned t = 1;; t = std::min(2 * t, maxThreads)) {
+        auto r = buscaEmLarguraParalela(grafo, s, t);
+        std::cerr << "[bfs] threads=" << t
+                  << " tempo=" << r.segundos * 1000.0 << " ms"
+                  << " teps=" << r.teps()
+                  << " teps_por_thread=" << r.teps() / t << std::endl;
+        if (t == maxThreads) break;
     }
-    
-    return niveis;
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 3) {
-        std::cerr << "Uso: " << argv[0] << " <arquivo_grafo> <vertice_inicial>" << std::endl;
+    if (argc != 3 && argc != 4) {
+        std::cerr << "Uso: " << argv[0] << " <arquivo_grafo> <vertice_inicial> [<threads>]" << std::endl;
         return 1;
     }
     
     std::string arquivo = argv[1];
-    int s = std::stoi(argv[2]);
-    
-    Grafo grafo(arquivo);
-    auto niveis = buscaEmLargura(grafo, s);
-    
-    // Ordena os níveis
-    std::vector<int> niveis_ordenados;
-    for (const auto& par : niveis) {
-        niveis_ordenados.push_back(par.first);
-    }
-    std::sort(niveis_ordenados.begin(), niveis_ordenados.end());
-    
-    for (int nivel : niveis_ordenados) {
-        std::cout << nivel << ": ";
-        
-        // Ordena vértices do nível
-        std::vector<int> vertices_nivel = niveis[nivel];
-        std::sort(vertices_nivel.begin(), vertices_nivel.end());
-        
-        for (size_t i = 0; i < vertices_nivel.size(); i++) {
-            if (i > 0) std::cout << ",";
-            std::cout << vertices_nivel[i];
-        }
-        std::cout << std::endl;
+    int s = std::stoi(argv[2]); // vértice inicial (1..n, conforme arquivo)
+    unsigned threads = 0;
+    if (argc == 4 && !lerThreads(argv[3], threads)) {
+        std::cerr << "Erro: número de threads inválido." << std::endl;
+        return 1;
     }
+    threads = threadsEfetivas(threads);
     
-    return 0;
-}
-    fila.push({s, 0});
-    visitado.insert(s);
-    niveis[0].push_back(s);
-    
-    while (!fila.empty()) {
-        auto [v, nivel] = fila.front();
-        fila.pop();
-        
-        for (int vizinho : grafo.vizinhos(v)) {
-            if (visitado.find(vizinho) == visitado.end()) {
-                visitado.insert(vizinho);
-                int proximo_nivel = nivel + 1;
-                fila.push({vizinho, proximo_nivel});
-                niveis[proximo_nivel].push_back(vizinho);
-            }
-        }
+    Grafo grafo(arquivo);
+    grafo.compactar();
+    auto resultado = buscaEmLarguraParalela(grafo, s, threads);
+
+    if (estatisticasAtivas()) {
+        std::cerr << "[bfs] threads=" << threads
+                  << " visitados=" << resultado.visitados
+                  << " niveis=" << resultado.profundidade + 1
+                  << " top-down=" << resultado.passosTopDown
+                  << " bottom-up=" << resultado.passosBottomUp
+                  << " arestas_examinadas=" << resultado.arestasExaminadas
+                  << " tempo=" << resultado.segundos * 1000.0 << " ms"
+                  << " teps=" << resultado.teps() << std::endl;
+        relatorioTEPS(grafo, s, threads);
     }
-    
-    return niveis;
-}
 
-int main(int argc, char* argv[]) {
-    if (argc != 3) {
-        std::cerr << "Uso: " << argv[0] << " <arquivo_grafo> <vertice_inicial>" << std::endl;
-        return 1;
+    // Vértice fora do grafo: só ele mesmo no nível 0
+    if (resultado.visitados == 0) {
+        std::cout << "0: " << s << std::endl;
+        return 0;
     }
     
-    std::string arquivo = argv[1];
-    int s = std::stoi(argv[2]); // vértice inicial (1..n, conforme arquivo)
-    
-    Grafo grafo(arquivo);
-    auto niveis = buscaEmLargura(grafo, s);
-    
-    // Ordena os níveis
-    std::vector<int> niveis_ordenados;
-    for (const auto& par : niveis) {
-        niveis_ordenados.push_back(par.first);
+    // Agrupa por nível; percorrer v em ordem crescente já deixa cada nível ordenado
+    std::vector<std::vector<int>> niveis(resultado.profundidade + 1);
+    for (int v = 0; v < static_cast<int>(resultado.nivel.size()); v++) {
+        if (resultado.nivel[v] >= 0) niveis[resultado.nivel[v]].push_back(v);
     }
-    std::sort(niveis_ordenados.begin(), niveis_ordenados.end());
     
-    for (int nivel : niveis_ordenados) {
+    for (int nivel = 0; nivel <= resultado.profundidade; nivel++) {
         std::cout << nivel << ": ";
         
-        // Ordena vértices do nível
-        std::vector<int> vertices_nivel = niveis[nivel];
-        std::sort(vertices_nivel.begin(), vertices_nivel.end());
-        
+        const std::vector<int>& vertices_nivel = niveis[nivel];
         for (size_t i = 0; i < vertices_nivel.size(); i++) {
             if (i > 0) std::cout << ",";
             std::cout << vertices_nivel[i];
         }
-        std::cout << std::endl;
+        std::cout << "\n";
     }
     
     return 0;
@@ -0,0 +1,311 @@
+#ifndef BUSCA_LARGURA_HPP
+#define BUSCA_LARGURA_HPP
+
+// BFS "direction-optimizing" (Beamer, Asanović e Patterson) sobre o CSR do Grafo.
+//
+// Top-down: cada vértice da fronteira olha seus vizinhos e reivindica os não visitados.
+// Bottom-up: cada vértice ainda não visitado procura um vizinho na fronteira e para no
+// primeiro que achar. Quando a fronteira cobre boa parte das arestas (grafos de diâmetro
+// baixo, livres de escala), o bottom-up examina muito menos arestas. A troca segue a
+// heurística do artigo:
+//   top-down -> bottom-up quando arestas da fronteira > arestas não exploradas / ALFA
+//   bottom-up -> top-down quando a fronteira encolhe para menos de n / BETA vértices
+// Visitados e fronteiras do bottom-up são bitsets densos; os níveis ficam num array plano.
+//
+// buscaEmLarguraParalela faz o mesmo passo a passo (nível a nível, com barreiras) em
+// várias threads. A fronteira é cortada em blocos repartidos com roubo de trabalho
+// (DivisaoTrabalho). No top-down, cada vértice é reivindicado por compare-and-swap na
+// palavra do bitset de visitados; no bottom-up, cada bloco cobre palavras inteiras do
+// bitset, então cada palavra tem uma única dona e dispensa atômicos de escrita. Cada
+// thread junta os vértices que descobriu num buffer próprio; no fim do nível os
+// buffers são copiados em paralelo para posições calculadas por soma de prefixos.
+// Como o nível de cada vértice é único, a saída não depende das threads.
+
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include "grafo.hpp"
+#include "paralelo.hpp"
+
+const int BFS_ALFA = 14;
+const int BFS_BETA = 24;
+
+struct ResultadoBFS {
+    std::vector<int> nivel;               // nivel[v] = distância em arestas até s, -1 se inalcançável
+    int profundidade = 0;                 // maior nível alcançado
+    std::uint64_t visitados = 0;
+    std::uint64_t arestasExaminadas = 0;
+    std::uint64_t arestasComponente = 0;  // entradas do CSR dos vértices alcançados (base do TEPS)
+    int passosTopDown = 0;
+    int passosBottomUp = 0;
+    unsigned threads = 1;
+    double segundos = 0.0;
+
+    // Arestas percorridas por segundo, como no Graph500 (cada aresta não dirigida conta uma vez)
+    double teps() const { return segundos > 0 ? arestasComponente / 2.0 / segundos : 0.0; }
+};
+
+// Bitset denso sobre 0..n-1
+class Bitset {
+private:
+    std::vector<std::uint64_t> palavras;
+
+public:
+    explicit Bitset(int n = 0) : palavras((n + 63) / 64, 0) {}
+
+    bool contem(int v) const { return (palavras[v >> 6] >> (v & 63)) & 1; }
+    void inserir(int v) { palavras[v >> 6] |= std::uint64_t(1) << (v & 63); }
+    void limpar() { std::fill(palavras.begin(), palavras.end(), 0); }
+    void trocar(Bitset& outro) { palavras.swap(outro.palavras); }
+};
+
+// Requer grafo.compactar()
+inline ResultadoBFS buscaEmLarguraDirecional(const Grafo& grafo, int s) {
+    auto inicio = std::chrono::steady_clock::now();
+    int tamanho = grafo.idMaximo() + 1;
+
+    ResultadoBFS r;
+    r.nivel.assign(tamanho, -1);
+    if (s < 0 || s >= tamanho) return r;
+
+    std::uint64_t arestasTotais = grafo.inicioVizinhanca(tamanho - 1) + grafo.grau(tamanho - 1);
+    std::uint64_t arestasNaoExploradas = arestasTotais;
+
+    Bitset visitado(tamanho);
+    Bitset fronteiraBits(tamanho);
+    Bitset proximaBits(tamanho);
+    std::vector<int> fronteira = {s};
+    std::vector<int> proxima;
+
+    visitado.inserir(s);
+    r.nivel[s] = 0;
+    r.visitados = 1;
+    std::uint64_t arestasFronteira = grafo.grau(s);
+    r.arestasComponente = arestasFronteira;
+    bool bottomUp = false;
+
+    for (int nivel = 1; !fronteira.empty(); nivel++) {
+        if (!bottomUp && arestasFronteira > arestasNaoExploradas / BFS_ALFA) {
+            bottomUp = true;
+            fronteiraBits.limpar();
+            for (int v : fronteira) fronteiraBits.inserir(v);
+        } else if (bottomUp && fronteira.size() < static_cast<std::size_t>(tamanho / BFS_BETA)) {
+            bottomUp = false;
+        }
+        arestasNaoExploradas -= std::min(arestasNaoExploradas, arestasFronteira);
+        arestasFronteira = 0;
+        proxima.clear();
+
+        if (bottomUp) {
+            r.passosBottomUp++;
+            proximaBits.limpar();
+            for (int v = 0; v < tamanho; v++) {
+                if (visitado.contem(v)) continue;
+                for (int u : grafo.vizinhanca(v)) {
+                    r.arestasExaminadas++;
+                    if (fronteiraBits.contem(u)) {
+                        visitado.inserir(v);
+                        proximaBits.inserir(v);
+                        proxima.push_back(v);
+                        break;
+                    }
+                }
+            }
+            fronteiraBits.trocar(proximaBits);
+        } else {
+            r.passosTopDown++;
+            for (int u : fronteira) {
+                for (int v : grafo.vizinhanca(u)) {
+                    r.arestasExaminadas++;
+                    if (!visitado.contem(v)) {
+                        visitado.inserir(v);
+                        proxima.push_back(v);
+                    }
+                }
+            }
+        }
+
+        for (int v : proxima) {
+            r.nivel[v] = nivel;
+            arestasFronteira += grafo.grau(v);
+        }
+        r.arestasComponente += arestasFronteira;
+        r.visitados += proxima.size();
+        if (!proxima.empty()) r.profundidade = nivel;
+        fronteira.swap(proxima);
+    }
+
+    r.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return r;
+}
+
+namespace bfs_detalhe {
+
+// Marca v como visitado; true só para a thread que trocou o bit de 0 para 1
+inline bool reivindicar(std::atomic<std::uint64_t>* palavras, int v) {
+    std::atomic<std::uint64_t>& palavra = palavras[v >> 6];
+    std::uint64_t bit = std::uint64_t(1) << (v & 63);
+    std::uint64_t atual = palavra.load(std::memory_order_relaxed);
+    while (!(atual & bit)) {
+        if (palavra.compare_exchange_weak(atual, atual | bit, std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+} // namespace bfs_detalhe
+
+// Requer grafo.compactar(). numThreads = 0 usa todos os núcleos; com 1 thread cai na versão sequencial.
+inline ResultadoBFS buscaEmLarguraParalela(const Grafo& grafo, int s, unsigned numThreads = 0) {
+    numThreads = threadsEfetivas(numThreads);
+    if (numThreads == 1) return buscaEmLarguraDirecional(grafo, s);
+
+    auto inicio = std::chrono::steady_clock::now();
+    int tamanho = grafo.idMaximo() + 1;
+
+    ResultadoBFS r;
+    r.threads = numThreads;
+    r.nivel.assign(tamanho, -1);
+    if (s < 0 || s >= tamanho) return r;
+
+    const std::size_t VERTICES_POR_BLOCO = 64;  // top-down: vértices da fronteira por bloco
+    const std::size_t PALAVRAS_POR_BLOCO = 16;  // bottom-up: 1024 vértices por bloco
+    std::size_t numPalavras = (static_cast<std::size_t>(tamanho) + 63) / 64;
+
+    std::unique_ptr<std::atomic<std::uint64_t>[]> visitado(new std::atomic<std::uint64_t>[numPalavras]);
+    for (std::size_t p = 0; p < numPalavras; p++) visitado[p].store(0, std::memory_order_relaxed);
+    std::vector<std::uint64_t> fronteiraBits(numPalavras, 0);
+    std::vector<std::uint64_t> proximaBits(numPalavras, 0);
+
+    std::vector<int> fronteira = {s};
+    std::vector<int> proxima;
+    std::vector<std::vector<int>> locais(numThreads);
+    std::vector<std::uint64_t> grausLocais(numThreads, 0);
+    std::vector<std::uint64_t> examinadasLocais(numThreads, 0);
+    std::vector<std::size_t> deslocamento(numThreads + 1, 0);
+
+    bfs_detalhe::reivindicar(visitado.get(), s);
+    r.nivel[s] = 0;
+    r.visitados = 1;
+
+    // Estado do nível, escrito só pela thread 0 entre barreiras
+    std::uint64_t arestasNaoExploradas = grafo.inicioVizinhanca(tamanho - 1) + grafo.grau(tamanho - 1);
+    std::uint64_t arestasFronteira = grafo.grau(s);
+    r.arestasComponente = arestasFronteira;
+    bool bottomUp = false;
+    bool terminou = false;
+    int nivelAtual = 0;
+
+    Barreira barreira(numThreads);
+    DivisaoTrabalho trabalho(numThreads);
+
+    auto trabalhar = [&](unsigned id) {
+        auto& meus = locais[id];
+        while (true) {
+            if (id == 0) {
+                terminou = fronteira.empty();
+                if (!terminou) {
+                    nivelAtual++;
+                    if (!bottomUp && arestasFronteira > arestasNaoExploradas / BFS_ALFA) {
+                        bottomUp = true;
+                        std::fill(fronteiraBits.begin(), fronteiraBits.end(), 0);
+                        for (int v : fronteira) fronteiraBits[v >> 6] |= std::uint64_t(1) << (v & 63);
+                    } else if (bottomUp && fronteira.size() < static_cast<std::size_t>(tamanho / BFS_BETA)) {
+                        bottomUp = false;
+                    }
+                    arestasNaoExploradas -= std::min(arestasNaoExploradas, arestasFronteira);
+                    if (bottomUp) {
+                        r.passosBottomUp++;
+                        std::fill(proximaBits.begin(), proximaBits.end(), 0);
+                        trabalho.preparar((numPalavras + PALAVRAS_POR_BLOCO - 1) / PALAVRAS_POR_BLOCO);
+                    } else {
+                        r.passosTopDown++;
+                        trabalho.preparar((fronteira.size() + VERTICES_POR_BLOCO - 1) / VERTICES_POR_BLOCO);
+                    }
+                }
+            }
+            barreira.esperar();
+            if (terminou) break;
+
+            meus.clear();
+            std::uint64_t graus = 0;
+            std::uint64_t examinadas = 0;
+            std::size_t bloco;
+            if (bottomUp) {
+                while (trabalho.pegar(id, bloco)) {
+                    std::size_t primeira = bloco * PALAVRAS_POR_BLOCO;
+                    std::size_t ultima = std::min(numPalavras, primeira + PALAVRAS_POR_BLOCO);
+                    for (std::size_t p = primeira; p < ultima; p++) {
+                        std::uint64_t livres = ~visitado[p].load(std::memory_order_relaxed);
+                        std::uint64_t novos = 0;
+                        while (livres) {
+                            int v = static_cast<int>(p * 64 + __builtin_ctzll(livres));
+                            livres &= livres - 1;
+                            if (v >= tamanho) break;
+                            for (int u : grafo.vizinhanca(v)) {
+                                examinadas++;
+                                if ((fronteiraBits[u >> 6] >> (u & 63)) & 1) {
+                                    novos |= std::uint64_t(1) << (v & 63);
+                                    r.nivel[v] = nivelAtual;
+                                    meus.push_back(v);
+                                    graus += grafo.grau(v);
+                                    break;
+                                }
+                            }
+                        }
+                        if (novos) {
+                            visitado[p].fetch_or(novos, std::memory_order_relaxed);
+                            proximaBits[p] = novos;
+                        }
+                    }
+                }
+            } else {
+                while (trabalho.pegar(id, bloco)) {
+                    std::size_t primeiro = bloco * VERTICES_POR_BLOCO;
+                    std::size_t ultimo = std::min(fronteira.size(), primeiro + VERTICES_POR_BLOCO);
+                    for (std::size_t i = primeiro; i < ultimo; i++) {
+                        for (int v : grafo.vizinhanca(fronteira[i])) {
+                            examinadas++;
+                            if (bfs_detalhe::reivindicar(visitado.get(), v)) {
+                                r.nivel[v] = nivelAtual;
+                                meus.push_back(v);
+                                graus += grafo.grau(v);
+                            }
+                        }
+                    }
+                }
+            }
+            grausLocais[id] = graus;
+            examinadasLocais[id] = examinadas;
+            barreira.esperar();
+
+            if (id == 0) {
+                arestasFronteira = 0;
+                for (unsigned t = 0; t < numThreads; t++) {
+                    deslocamento[t + 1] = deslocamento[t] + locais[t].size();
+                    arestasFronteira += grausLocais[t];
+                    r.arestasExaminadas += examinadasLocais[t];
+                }
+                proxima.resize(deslocamento[numThreads]);
+                r.arestasComponente += arestasFronteira;
+                r.visitados += proxima.size();
+                if (!proxima.empty()) r.profundidade = nivelAtual;
+                if (bottomUp) fronteiraBits.swap(proximaBits);
+            }
+            barreira.esperar();
+
+            // Junção sem trava: cada thread copia seu buffer para a sua fatia
+            std::copy(meus.begin(), meus.end(), proxima.begin() + deslocamento[id]);
+            barreira.esperar();
+            if (id == 0) fronteira.swap(proxima);
+        }
+    };
+    emParalelo(numThreads, trabalhar);
+
+    r.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return r;
+}
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef CARTEIRO_CHINES_HPP
+#define CARTEIRO_CHINES_HPP
+
+// Carteiro chinês (route inspection) em grafo não-dirigido: o passeio fechado de peso
+// mínimo que passa por todas as arestas.
+//
+//   1. vértices de grau ímpar (sempre em número par);
+//   2. distâncias entre eles com Dijkstra multi-fonte em paralelo (johnson.hpp, que
+//      para cada busca assim que todos os ímpares estão assentados);
+//   3. emparelhamento perfeito de peso mínimo entre os ímpares (emparelhamento.hpp);
+//   4. o caminho mínimo de cada par emparelhado entra como arestas duplicadas, e o
+//      multigrafo resultante, todo de grau par, vai para o MotorEuler.
+
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include "grafo.hpp"
+#include "paralelo.hpp"
+#include "johnson.hpp"
+#include "ponto_a_ponto.hpp"
+#include "emparelhamento.hpp"
+#include "ciclo_euleriano.hpp"
+
+struct ResultadoCarteiro {
+    bool possivel = false;                 // arestas conexas e sem pesos negativos
+    std::unique_ptr<MotorEuler> rota;      // multigrafo euleriano (original + duplicadas)
+    int inicio = -1;
+    int impares = 0;
+    std::uint64_t arestasDuplicadas = 0;
+    double custoOriginal = 0.0;            // soma dos pesos das arestas do grafo
+    double custoExtra = 0.0;               // soma dos caminhos emparelhados
+    int rodadasEmparelhamento = 0;
+    double segundosDistancias = 0.0;
+    double segundosEmparelhamento = 0.0;
+    double segundosCaminhos = 0.0;
+
+    double custoTotal() const { return custoOriginal + custoExtra; }
+};
+
+// numThreads = 0 usa todos os núcleos. Requer grafo.compactar().
+inline ResultadoCarteiro carteiroChines(const Grafo& grafo, unsigned numThreads = 0) {
+    using relogio = std::chrono::steady_clock;
+    numThreads = threadsEfetivas(numThreads);
+    int tamanho = grafo.idMaximo() + 1;
+    ResultadoCarteiro r;
+
+    MotorEuler original(grafo);
+    std::vector<double> h;
+    int rodadasBF = 0;
+    // Com uma aresta negativa dá para ir e voltar nela para sempre: não há mínimo
+    if (!original.arestasConexas() || !potenciaisJohnson(grafo, h, rodadasBF)) return r;
+    r.possivel = true;
+    r.inicio = original.primeiroComAresta();
+
+    std::vector<int> impares;
+    for (int v = 0; v < tamanho; v++) {
+        auto vizinhos = grafo.vizinhanca(v);
+        auto pesos = grafo.pesosVizinhanca(v);
+        for (std::size_t i = 0; i < vizinhos.size(); i++) {
+            if (vizinhos[i] >= v) r.custoOriginal += pesos[i];
+        }
+        if (original.grau(v) % 2 != 0) impares.push_back(v);
+    }
+    int k = impares.size();
+    r.impares = k;
+
+    // Distâncias entre os ímpares: dist[i * k + j]
+    auto t0 = relogio::now();
+    std::vector<double> dist(static_cast<std::size_t>(k) * k);
+    johnson(grafo, impares, h, numThreads, [&](int i, const double* linha) {
+        std::copy(linha, linha + k, dist.begin() + static_cast<std::size_t>(i) * k);
+    });
+    auto t1 = relogio::now();
+    std::vector<int> parceiro = emparelhamentoPerfeitoMinimo(dist, k, numThreads, r.rodadasEmparelhamento);
+    auto t2 = relogio::now();
+    r.segundosDistancias = std::chrono::duration<double>(t1 - t0).count();
+    r.segundosEmparelhamento = std::chrono::duration<double>(t2 - t1).count();
+
+    // Caminho mínimo de cada par, em paralelo
+    std::vector<std::pair<int, int>> pares;
+    for (int i = 0; i < k; i++) {
+        if (parceiro.size() == static_cast<std::size_t>(k) && i < parceiro[i]) pares.push_back({i, parceiro[i]});
+    }
+    std::vector<std::vector<int>> caminhos(pares.size());
+    DivisaoTrabalho trabalho(numThreads);
+    trabalho.preparar(pares.size());
+    emParalelo(numThreads, [&](unsigned id) {
+        std::size_t b;
+        while (trabalho.pegar(id, b)) {
+            caminhos[b] = dijkstraBidirecional(grafo, impares[pares[b].first], impares[pares[b].second]).caminho;
+        }
+    });
+    for (std::size_t b = 0; b < pares.size(); b++) {
+        r.custoExtra += dist[static_cast<std::size_t>(pares[b].first) * k + pares[b].second];
+    }
+    r.segundosCaminhos = std::chrono::duration<double>(relogio::now() - t2).count();
+
+    // Multigrafo: linhas do grafo + arestas duplicadas, cada linha em ordem crescente
+    std::vector<std::uint64_t> offsets(tamanho + 1, 0);
+    for (int v = 0; v < tamanho; v++) offsets[v + 1] = grafo.vizinhanca(v).size();
+    for (const auto& caminho : caminhos) {
+        for (std::size_t i = 0; i + 1 < caminho.size(); i++) {
+            offsets[caminho[i] + 1]++;
+            offsets[caminho[i + 1] + 1]++;
+            r.arestasDuplicadas++;
+        }
+    }
+    for (int v = 0; v < tamanho; v++) offsets[v + 1] += offsets[v];
+    std::vector<int> destinos(offsets[tamanho]);
+    std::vector<std::uint64_t> proximo(offsets.begin(), offsets.end() - 1);
+    for (int v = 0; v < tamanho; v++) {
+        for (int u : grafo.vizinhanca(v)) destinos[proximo[v]++] = u;
+    }
+    for (const auto& caminho : caminhos) {
+        for (std::size_t i = 0; i + 1 < caminho.size(); i++) {
+            destinos[proximo[caminho[i]]++] = caminho[i + 1];
+            destinos[proximo[caminho[i + 1]]++] = caminho[i];
+        }
+    }
+    for (int v = 0; v < tamanho; v++) {
+        std::sort(destinos.begin() + offsets[v], destinos.begin() + offsets[v + 1]);
+    }
+    r.rota = std::make_unique<MotorEuler>(std::move(offsets), std::move(destinos));
+    return r;
+}
+
+#endif
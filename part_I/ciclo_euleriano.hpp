@@ -0,0 +1,166 @@
+#ifndef CICLO_EULERIANO_HPP
+#define CICLO_EULERIANO_HPP
+
+// Hierholzer em O(V + E) sobre semiarestas em CSR.
+//
+// Cada aresta não-dirigida u-v é um par de semiarestas (u -> v na linha de u e
+// v -> u na linha de v); par[p] aponta a semiaresta de volta (num laço, a própria p).
+// Usar uma aresta marca as duas no bitmap `usada`, e cada vértice guarda um cursor
+// para a próxima semiaresta da sua linha, que só anda para trás: nenhuma aresta é
+// examinada mais de duas vezes e nada é apagado de lista nenhuma.
+//
+// As linhas vêm em ordem crescente de destino e o cursor começa no fim, então a
+// escolha do próximo vizinho é a mesma do Hierholzer antigo (maior vizinho primeiro).
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "grafo.hpp"
+
+class MotorEuler {
+private:
+    int tamanho = 0;
+    const std::uint64_t* offsets = nullptr;
+    const int* destinos = nullptr;
+    // num_arestas do Grafo é int, então as 2m semiarestas cabem em uint32
+    std::vector<std::uint32_t> par;
+    std::vector<std::uint64_t> offsetsProprios;
+    std::vector<int> destinosProprios;
+    bool simetrico = false;
+
+    std::uint64_t entradas() const {
+        return tamanho > 0 ? offsets[tamanho] : 0;
+    }
+
+    // Liga cada semiaresta à de volta em O(E). Percorrendo u em ordem crescente, as
+    // semiarestas v -> u (v < u) aparecem na linha de v também em ordem crescente de u,
+    // então basta um cursor por vértice. Arestas repetidas casam na mesma ordem.
+    void ligarPares() {
+        par.assign(entradas(), 0);
+        std::vector<std::uint64_t> cursor(tamanho);
+        for (int v = 0; v < tamanho; v++) {
+            cursor[v] = std::upper_bound(destinos + offsets[v], destinos + offsets[v + 1], v) - destinos;
+        }
+        for (int u = 0; u < tamanho; u++) {
+            for (std::uint64_t p = offsets[u]; p < offsets[u + 1]; p++) {
+                int v = destinos[p];
+                if (v < 0 || v >= tamanho) return;
+                if (v == u) {
+                    par[p] = static_cast<std::uint32_t>(p);
+                } else if (v < u) {
+                    std::uint64_t q = cursor[v]++;
+                    if (q >= offsets[v + 1] || destinos[q] != u) return; // linhas não simétricas
+                    par[p] = static_cast<std::uint32_t>(q);
+                    par[q] = static_cast<std::uint32_t>(p);
+                }
+            }
+        }
+        for (int v = 0; v < tamanho; v++) {
+            if (cursor[v] != offsets[v + 1]) return;
+        }
+        simetrico = true;
+    }
+
+public:
+    // Semiarestas do próprio CSR do grafo (requer compactar()); nada é copiado além de par
+    explicit MotorEuler(const Grafo& grafo) : tamanho(grafo.idMaximo() + 1) {
+        if (tamanho <= 0) return;
+        offsetsProprios.resize(tamanho + 1);
+        for (int v = 0; v < tamanho; v++) {
+            offsetsProprios[v] = grafo.inicioVizinhanca(v);
+        }
+        offsetsProprios[tamanho] = offsetsProprios[tamanho - 1] + grafo.vizinhanca(tamanho - 1).size();
+        offsets = offsetsProprios.data();
+        // Início do array de destinos do CSR, a partir de qualquer linha não vazia
+        for (int v = 0; v < tamanho && destinos == nullptr; v++) {
+            if (!grafo.vizinhanca(v).empty()) destinos = grafo.vizinhanca(v).begin() - offsets[v];
+        }
+        ligarPares();
+    }
+
+    // Multigrafo montado à parte: linhas em ordem crescente de destino, cada aresta u-v
+    // presente nas duas linhas (um laço aparece uma vez só na sua linha)
+    MotorEuler(std::vector<std::uint64_t> offsetsLinhas, std::vector<int> destinosLinhas)
+        : tamanho(static_cast<int>(offsetsLinhas.size()) - 1),
+          offsetsProprios(std::move(offsetsLinhas)), destinosProprios(std::move(destinosLinhas)) {
+        if (tamanho <= 0) return;
+        offsets = offsetsProprios.data();
+        destinos = destinosProprios.data();
+        ligarPares();
+    }
+
+    // Grau com laços contando 2
+    int grau(int v) const {
+        int g = 0;
+        for (std::uint64_t p = offsets[v]; p < offsets[v + 1]; p++) g += destinos[p] == v ? 2 : 1;
+        return g;
+    }
+
+    // Primeiro vértice (menor id) com alguma aresta, ou -1
+    int primeiroComAresta() const {
+        for (int v = 0; v < tamanho; v++) {
+            if (offsets[v + 1] > offsets[v]) return v;
+        }
+        return -1;
+    }
+
+    // Todas as arestas numa só componente (DFS com array denso)
+    bool arestasConexas() const {
+        int inicio = primeiroComAresta();
+        if (!simetrico || inicio < 0) return false;
+        std::vector<char> visitado(tamanho, 0);
+        std::vector<int> pilha = {inicio};
+        visitado[inicio] = 1;
+        while (!pilha.empty()) {
+            int v = pilha.back();
+            pilha.pop_back();
+            for (std::uint64_t p = offsets[v]; p < offsets[v + 1]; p++) {
+                int u = destinos[p];
+                if (!visitado[u]) {
+                    visitado[u] = 1;
+                    pilha.push_back(u);
+                }
+            }
+        }
+        for (int v = 0; v < tamanho; v++) {
+            if (offsets[v + 1] > offsets[v] && !visitado[v]) return false;
+        }
+        return true;
+    }
+
+    // Todos os graus pares e arestas conexas
+    bool temCicloEuleriano() const {
+        if (!simetrico || primeiroComAresta() < 0) return false;
+        for (int v = 0; v < tamanho; v++) {
+            if (grau(v) % 2 != 0) return false;
+        }
+        return arestasConexas();
+    }
+
+    // Hierholzer iterativo a partir de inicio. visitar(v) recebe os vértices do ciclo
+    // na ordem em que saem da pilha: o primeiro e o último são inicio, e a sequência é um
+    // ciclo euleriano (o percurso ao contrário), sem guardar o ciclo inteiro.
+    template <typename F>
+    void percorrer(int inicio, F visitar) {
+        std::vector<std::uint64_t> usada((entradas() + 63) / 64, 0);
+        std::vector<std::uint64_t> cursor(offsets + 1, offsets + tamanho + 1);
+        std::vector<int> pilha = {inicio};
+        while (!pilha.empty()) {
+            int v = pilha.back();
+            std::uint64_t& c = cursor[v];
+            while (c > offsets[v] && (usada[(c - 1) >> 6] >> ((c - 1) & 63) & 1)) c--;
+            if (c > offsets[v]) {
+                std::uint64_t p = --c;
+                std::uint64_t q = par[p];
+                usada[p >> 6] |= std::uint64_t(1) << (p & 63);
+                usada[q >> 6] |= std::uint64_t(1) << (q & 63);
+                pilha.push_back(destinos[p]);
+            } else {
+                visitar(v);
+                pilha.pop_back();
+            }
+        }
+    }
+};
+
+#endif
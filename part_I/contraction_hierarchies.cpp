@@ -0,0 +1,74 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <limits>
+#include "grafo.hpp"
+#include "hierarquia_contracao.hpp"
+
+void imprimirCaminho(int v, const std::vector<int>& caminho, double dist) {
+    std::cout << v << ": ";
+    for (size_t i = 0; i < caminho.size(); i++) {
+        if (i > 0) std::cout << ",";
+        std::cout << caminho[i];
+    }
+    std::cout << "; d=";
+    if (dist == std::numeric_limits<double>::infinity())
+        std::cout << "inf";
+    else
+        std::cout << dist;
+    std::cout << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 4 && !(argc == 3 && std::string(argv[2]) == "-")) {
+        std::cerr << "Uso: " << argv[0] << " <arquivo_grafo> <vertice_inicial> <vertice_final>" << std::endl;
+        std::cerr << "     " << argv[0] << " <arquivo_grafo> -    (pares \"s t\" lidos da entrada padrão)" << std::endl;
+        return 1;
+    }
+
+    std::string arquivo = argv[1];
+    Grafo grafo(arquivo);
+    grafo.compactar();
+
+    // Pré-processamento uma vez só: fica em <arquivo>.ch para as próximas execuções
+    HierarquiaContracao h = hierarquiaDoGrafo(grafo, arquivo);
+    ConsultaCH consulta(h);
+
+    std::uint64_t consultas = 0;
+    std::uint64_t assentados = 0;
+    double segundos = 0.0;
+    auto responder = [&](int s, int t) {
+        ResultadoPontoAPonto r = consulta.consultar(s, t);
+        consultas++;
+        assentados += r.assentados;
+        segundos += r.segundos;
+        // Inalcançável: mesmo formato do dijkstra ("t: t; d=inf")
+        if (r.caminho.empty()) r.caminho.push_back(t);
+        imprimirCaminho(t, r.caminho, r.dist);
+    };
+
+    if (argc == 4) {
+        responder(std::stoi(argv[2]), std::stoi(argv[3]));
+    } else {
+        int s, t;
+        while (std::cin >> s >> t) responder(s, t);
+    }
+    std::cout.flush();
+
+    if (estatisticasAtivas()) {
+        std::cerr << "[ch] atalhos=" << h.atalhos
+                  << " nucleo=" << h.nucleo
+                  << " arestas_para_cima=" << h.destinos.size();
+        if (h.segundos > 0) {
+            std::cerr << " preprocessamento=" << h.segundos * 1000.0 << " ms" << std::endl;
+        } else {
+            std::cerr << " (lida de " << arquivo << ".ch)" << std::endl;
+        }
+        if (consultas > 0) {
+            std::cerr << "[ch] consultas=" << consultas
+                      << " assentados_medio=" << static_cast<double>(assentados) / consultas
+                      << " tempo_medio=" << segundos * 1e6 / consultas << " us" << std::endl;
+        }
+    }
+    return 0;
+}
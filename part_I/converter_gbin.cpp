@@ -0,0 +1,29 @@
+#include <iostream>
+#include <chrono>
+#include "grafo.hpp"
+
+// Converte um .net para o formato binário .gbin (CSR mapeável em memória).
+// Depois disso, bfs/dijkstra/euler/fw aceitam o .gbin no lugar do .net.
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Uso: " << argv[0] << " <arquivo_grafo.net> <saida.gbin>" << std::endl;
+        return 1;
+    }
+
+    std::string entrada = argv[1];
+    std::string saida = argv[2];
+
+    auto inicio = std::chrono::steady_clock::now();
+    Grafo grafo(entrada);
+    grafo.compactar();
+    if (!grafo.salvarSnapshot(saida)) {
+        std::cerr << "Erro ao gravar snapshot: " << saida << std::endl;
+        return 1;
+    }
+    auto fim = std::chrono::steady_clock::now();
+
+    std::cout << saida << ": " << grafo.qtdVertices() << " vertices, " << grafo.qtdArestas()
+              << " arestas (" << std::chrono::duration<double, std::milli>(fim - inicio).count()
+              << " ms)" << std::endl;
+    return 0;
+}
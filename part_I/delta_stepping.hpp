@@ -0,0 +1,286 @@
+#ifndef DELTA_STEPPING_HPP
+#define DELTA_STEPPING_HPP
+
+// Delta-stepping (Meyer & Sanders) paralelo sobre o CSR do Grafo.
+//
+// Os vértices ficam em baldes de largura delta pela distância provisória. O menor
+// balde não vazio é esvaziado em rodadas: todas as threads relaxam as arestas leves
+// (peso <= delta) da fronteira ao mesmo tempo, o que pode devolver vértices ao mesmo
+// balde; quando ele fica vazio, as arestas pesadas dos vértices assentados nele são
+// relaxadas uma única vez. Distâncias são atualizadas com compare-and-swap e cada
+// thread guarda os vértices que alcançou nos seus próprios baldes (sem trava);
+// a thread 0 junta esses buffers na fronteira da rodada seguinte.
+//
+// Os antecessores são escolhidos no fim, de forma determinística: entre os vizinhos u
+// com dist[u] + w(u, v) == dist[v], o de menor distância e, no empate, o de menor índice.
+// Assim a saída não depende do número de threads nem da ordem dos relaxamentos.
+
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include "grafo.hpp"
+#include "paralelo.hpp"
+
+struct ResultadoDeltaStepping {
+    std::vector<double> dist;
+    std::vector<int> antecessor;
+    double delta = 0.0;
+    unsigned threads = 1;
+    std::uint64_t baldes = 0;         // baldes processados
+    std::uint64_t rodadas = 0;        // rodadas de arestas leves (cada uma termina numa barreira)
+    std::uint64_t relaxamentos = 0;   // relaxamentos que melhoraram uma distância
+    double segundos = 0.0;
+};
+
+namespace delta_detalhe {
+
+// dist = min(dist, nova); devolve true se baixou
+inline bool reduzir(std::atomic<double>& dist, double nova) {
+    double atual = dist.load(std::memory_order_relaxed);
+    while (nova < atual) {
+        if (dist.compare_exchange_weak(atual, nova, std::memory_order_relaxed)) return true;
+    }
+    return false;
+}
+
+} // namespace delta_detalhe
+
+// Delta de Meyer & Sanders: peso máximo / grau médio. Com pesos aleatórios isso deixa
+// ~1 aresta leve por vértice e mantém o número de rodadas por balde pequeno.
+inline double deltaAutomatico(const Grafo& grafo) {
+    double pesoMaximo = 0;
+    std::uint64_t entradas = 0;
+    int comArestas = 0;
+    for (int v = 0; v <= grafo.idMaximo(); v++) {
+        auto pesos = grafo.pesosVizinhanca(v);
+        if (pesos.empty()) continue;
+        comArestas++;
+        entradas += pesos.size();
+        for (double w : pesos) pesoMaximo = std::max(pesoMaximo, w);
+    }
+    if (pesoMaximo <= 0 || comArestas == 0) return 1.0;
+    double grauMedio = static_cast<double>(entradas) / comArestas;
+    return pesoMaximo / std::max(1.0, grauMedio);
+}
+
+// Requer grafo.compactar() e pesos não negativos. numThreads = 0 usa todos os núcleos;
+// delta <= 0 usa deltaAutomatico(). Vértices inalcançáveis ficam com dist = inf e antecessor = -1.
+inline ResultadoDeltaStepping deltaStepping(const Grafo& grafo, int s, unsigned numThreads = 0, double delta = 0) {
+    using delta_detalhe::reduzir;
+    auto inicio = std::chrono::steady_clock::now();
+    const double INF = std::numeric_limits<double>::infinity();
+    int tamanho = grafo.idMaximo() + 1;
+
+    ResultadoDeltaStepping r;
+    numThreads = threadsEfetivas(numThreads);
+    if (delta <= 0) delta = deltaAutomatico(grafo);
+    r.threads = numThreads;
+    r.delta = delta;
+    r.dist.assign(tamanho, INF);
+    r.antecessor.assign(tamanho, -1);
+    if (s < 0 || s >= tamanho) return r;
+
+    // Cópia do CSR com cada linha particionada: [leves | pesadas]. As linhas ocupam
+    // as mesmas posições do CSR original, então os offsets são reaproveitados.
+    std::size_t entradas = grafo.inicioVizinhanca(tamanho - 1) + grafo.grau(tamanho - 1);
+    std::vector<int> destinos(entradas);
+    std::vector<double> pesos(entradas);
+    std::vector<std::size_t> divisa(tamanho);
+    double pesoMaximo = 0;
+    for (int v = 0; v < tamanho; v++) {
+        for (double w : grafo.pesosVizinhanca(v)) pesoMaximo = std::max(pesoMaximo, w);
+    }
+    emFaixas(tamanho, numThreads, [&](int a, int b) {
+        for (int v = a; v < b; v++) {
+            auto vizinhos = grafo.vizinhanca(v);
+            auto pv = grafo.pesosVizinhanca(v);
+            std::size_t pos = grafo.inicioVizinhanca(v);
+            for (std::size_t i = 0; i < vizinhos.size(); i++) {
+                if (pv[i] <= delta) {
+                    destinos[pos] = vizinhos[i];
+                    pesos[pos++] = pv[i];
+                }
+            }
+            divisa[v] = pos;
+            for (std::size_t i = 0; i < vizinhos.size(); i++) {
+                if (pv[i] > delta) {
+                    destinos[pos] = vizinhos[i];
+                    pesos[pos++] = pv[i];
+                }
+            }
+        }
+    });
+
+    std::unique_ptr<std::atomic<double>[]> dist(new std::atomic<double>[tamanho]);
+    std::unique_ptr<std::atomic<std::uint32_t>[]> marcaRodada(new std::atomic<std::uint32_t>[tamanho]);
+    std::unique_ptr<std::atomic<std::uint64_t>[]> marcaBalde(new std::atomic<std::uint64_t>[tamanho]);
+    for (int v = 0; v < tamanho; v++) {
+        dist[v].store(INF, std::memory_order_relaxed);
+        marcaRodada[v].store(0, std::memory_order_relaxed);
+        marcaBalde[v].store(0, std::memory_order_relaxed);
+    }
+
+    // Uma chave nova nunca passa de (balde atual + 1) * delta + pesoMaximo, então
+    // uma janela circular de pesoMaximo / delta + 3 baldes basta
+    std::size_t numBaldes = static_cast<std::size_t>(pesoMaximo / delta) + 3;
+    auto baldeDe = [delta](double d) { return static_cast<std::uint64_t>(d / delta); };
+
+    std::vector<std::vector<std::vector<int>>> locais(numThreads, std::vector<std::vector<int>>(numBaldes));
+    std::vector<std::vector<int>> assentados(numThreads);
+    std::vector<std::uint64_t> relaxamentos(numThreads, 0);
+
+    // Estado compartilhado, escrito só pela thread 0 entre barreiras
+    std::vector<int> fronteira;
+    std::atomic<std::size_t> proximo(0);
+    std::uint64_t baldeAtual = 0;
+    std::uint32_t rodada = 0;
+    bool terminou = false;
+    bool fronteiraVazia = false;
+
+    dist[s].store(0, std::memory_order_relaxed);
+    locais[0][0].push_back(s);
+
+    Barreira barreira(numThreads);
+    const std::size_t BLOCO = 256;
+
+    auto trabalhar = [&](unsigned id) {
+        auto& meus = locais[id];
+        auto& meusAssentados = assentados[id];
+        std::uint64_t meusRelaxamentos = 0;
+
+        auto relaxar = [&](double dv, std::size_t de, std::size_t ate) {
+            for (std::size_t e = de; e < ate; e++) {
+                double nova = dv + pesos[e];
+                int w = destinos[e];
+                if (reduzir(dist[w], nova)) {
+                    meus[baldeDe(nova) % numBaldes].push_back(w);
+                    meusRelaxamentos++;
+                }
+            }
+        };
+
+        bool primeiro = true;
+        while (true) {
+            barreira.esperar();
+            if (id == 0) {
+                // Próximo balde com algo, olhando os buffers de todas as threads
+                terminou = true;
+                for (std::size_t k = primeiro ? 0 : 1; k < numBaldes && terminou; k++) {
+                    std::size_t pos = (baldeAtual + k) % numBaldes;
+                    for (unsigned t = 0; t < numThreads; t++) {
+                        if (!locais[t][pos].empty()) {
+                            baldeAtual += k;
+                            terminou = false;
+                            break;
+                        }
+                    }
+                }
+                if (!terminou) r.baldes++;
+            }
+            primeiro = false;
+            barreira.esperar();
+            if (terminou) break;
+
+            std::size_t pos = baldeAtual % numBaldes;
+            while (true) {
+                if (id == 0) {
+                    fronteira.clear();
+                    for (unsigned t = 0; t < numThreads; t++) {
+                        fronteira.insert(fronteira.end(), locais[t][pos].begin(), locais[t][pos].end());
+                        locais[t][pos].clear();
+                    }
+                    proximo.store(0, std::memory_order_relaxed);
+                    rodada++;
+                    fronteiraVazia = fronteira.empty();
+                    if (!fronteiraVazia) r.rodadas++;
+                }
+                barreira.esperar();
+                if (fronteiraVazia) break;
+
+                // Arestas leves, com a fronteira distribuída em blocos sob demanda
+                while (true) {
+                    std::size_t inicioBloco = proximo.fetch_add(BLOCO, std::memory_order_relaxed);
+                    if (inicioBloco >= fronteira.size()) break;
+                    std::size_t fimBloco = std::min(fronteira.size(), inicioBloco + BLOCO);
+                    for (std::size_t i = inicioBloco; i < fimBloco; i++) {
+                        int v = fronteira[i];
+                        double dv = dist[v].load(std::memory_order_relaxed);
+                        if (baldeDe(dv) != baldeAtual) continue; // entrada obsoleta
+                        if (marcaRodada[v].exchange(rodada, std::memory_order_relaxed) == rodada) continue;
+                        if (marcaBalde[v].exchange(baldeAtual + 1, std::memory_order_relaxed) != baldeAtual + 1) {
+                            meusAssentados.push_back(v);
+                        }
+                        relaxar(dv, grafo.inicioVizinhanca(v), divisa[v]);
+                    }
+                }
+                barreira.esperar();
+            }
+
+            // Arestas pesadas: as distâncias deste balde já são finais
+            for (int v : meusAssentados) {
+                relaxar(dist[v].load(std::memory_order_relaxed), divisa[v],
+                        grafo.inicioVizinhanca(v) + grafo.grau(v));
+            }
+            meusAssentados.clear();
+        }
+        relaxamentos[id] = meusRelaxamentos;
+    };
+
+    emParalelo(numThreads, trabalhar);
+    for (auto n : relaxamentos) r.relaxamentos += n;
+
+    for (int v = 0; v < tamanho; v++) r.dist[v] = dist[v].load(std::memory_order_relaxed);
+
+    // Antecessores: aresta "apertada" vinda do vizinho de menor distância (e menor índice)
+    std::vector<int>& antecessor = r.antecessor;
+    const std::vector<double>& d = r.dist;
+    emFaixas(tamanho, numThreads, [&](int a, int b) {
+        for (int v = a; v < b; v++) {
+            if (v == s || d[v] == INF) continue;
+            auto vizinhos = grafo.vizinhanca(v);
+            auto pv = grafo.pesosVizinhanca(v);
+            for (std::size_t i = 0; i < vizinhos.size(); i++) {
+                int u = vizinhos[i];
+                if (d[u] < d[v] && d[u] + pv[i] == d[v] &&
+                    (antecessor[v] < 0 || d[u] < d[antecessor[v]] ||
+                     (d[u] == d[antecessor[v]] && u < antecessor[v]))) {
+                    antecessor[v] = u;
+                }
+            }
+        }
+    });
+    // Vértices alcançados só por arestas de peso 0 (mesma distância do antecessor):
+    // busca em largura por essas arestas a partir dos que já têm antecessor, para não formar ciclos
+    std::vector<int> pendentes;
+    for (int v = 0; v < tamanho; v++) {
+        if (v != s && d[v] != INF && antecessor[v] < 0) pendentes.push_back(v);
+    }
+    if (!pendentes.empty()) {
+        std::vector<int> fila;
+        for (int v = 0; v < tamanho; v++) {
+            if (v == s || antecessor[v] >= 0) fila.push_back(v);
+        }
+        for (std::size_t i = 0; i < fila.size(); i++) {
+            int u = fila[i];
+            auto vizinhos = grafo.vizinhanca(u);
+            auto pv = grafo.pesosVizinhanca(u);
+            for (std::size_t j = 0; j < vizinhos.size(); j++) {
+                int v = vizinhos[j];
+                if (v != s && antecessor[v] < 0 && d[v] != INF && d[u] + pv[j] == d[v]) {
+                    antecessor[v] = u;
+                    fila.push_back(v);
+                }
+            }
+        }
+    }
+
+    r.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return r;
+}
+
+#endif
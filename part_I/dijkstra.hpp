@@ -0,0 +1,138 @@
+#ifndef DIJKSTRA_HPP
+#define DIJKSTRA_HPP
+
+// Dijkstra sobre o CSR do Grafo com fila de prioridade plugável.
+// Distâncias e antecessores ficam em arrays planos indexados pelo vértice
+// (0..idMaximo), e cada relaxamento lê vizinho e peso direto do CSR.
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include "grafo.hpp"
+#include "filas_prioridade.hpp"
+
+enum class TipoFila { AUTOMATICA, HEAP4, RADIX, DIAL };
+
+// Pesos inteiros até este valor usam os baldes de Dial
+const std::uint64_t LIMITE_PESO_DIAL = 256;
+
+struct ResultadoDijkstra {
+    std::vector<double> dist;
+    std::vector<int> antecessor;
+    ContadoresFila contadores;
+    std::uint64_t relaxamentos = 0;
+    TipoFila fila = TipoFila::HEAP4;
+    double segundos = 0.0;
+};
+
+inline const char* nomeFila(TipoFila tipo) {
+    switch (tipo) {
+        case TipoFila::HEAP4: return "heap4";
+        case TipoFila::RADIX: return "radix";
+        case TipoFila::DIAL: return "dial";
+        default: return "auto";
+    }
+}
+
+// "heap4", "radix" ou "dial"; qualquer outro valor deixa a escolha automática
+inline TipoFila tipoFilaPorNome(const std::string& nome) {
+    if (nome == "heap4") return TipoFila::HEAP4;
+    if (nome == "radix") return TipoFila::RADIX;
+    if (nome == "dial") return TipoFila::DIAL;
+    return TipoFila::AUTOMATICA;
+}
+
+// Escolhe a fila pelos pesos: inteiros pequenos -> Dial, inteiros não negativos -> radix,
+// caso geral -> heap 4-ário. pesoMaximo recebe o maior peso (se forem todos inteiros).
+inline TipoFila escolherFila(const Grafo& grafo, std::uint64_t& pesoMaximo) {
+    pesoMaximo = 0;
+    for (int v = 0; v <= grafo.idMaximo(); v++) {
+        for (double w : grafo.pesosVizinhanca(v)) {
+            if (w < 0 || w != std::floor(w) || w > 4294967295.0) {
+                return TipoFila::HEAP4;
+            }
+            pesoMaximo = std::max(pesoMaximo, static_cast<std::uint64_t>(w));
+        }
+    }
+    return pesoMaximo <= LIMITE_PESO_DIAL ? TipoFila::DIAL : TipoFila::RADIX;
+}
+
+template <typename Fila>
+void executarDijkstra(const Grafo& grafo, int s, Fila& fila, ResultadoDijkstra& r) {
+    using Chave = typename Fila::Chave;
+    r.dist[s] = 0;
+    fila.inserirOuReduzir(s, Chave(0));
+
+    while (!fila.vazia()) {
+        int u = fila.removerMinimo();
+        double du = r.dist[u];
+
+        // Relaxamento (vizinhos e pesos lidos direto do CSR)
+        auto vizinhos = grafo.vizinhanca(u);
+        auto pesos = grafo.pesosVizinhanca(u);
+        for (std::size_t i = 0; i < vizinhos.size(); i++) {
+            int viz = vizinhos[i];
+            double nova = du + pesos[i];
+            if (nova < r.dist[viz]) {
+                r.dist[viz] = nova;
+                r.antecessor[viz] = u;
+                fila.inserirOuReduzir(viz, static_cast<Chave>(nova));
+                r.relaxamentos++;
+            }
+        }
+    }
+    r.contadores = fila.contadores;
+}
+
+// Requer grafo.compactar(). Vértices inalcançáveis ficam com dist = inf e antecessor = -1.
+inline ResultadoDijkstra dijkstra(const Grafo& grafo, int s, TipoFila tipo = TipoFila::AUTOMATICA) {
+    auto inicio = std::chrono::steady_clock::now();
+    int tamanho = grafo.idMaximo() + 1;
+
+    ResultadoDijkstra r;
+    r.dist.assign(tamanho, std::numeric_limits<double>::infinity());
+    r.antecessor.assign(tamanho, -1);
+
+    std::uint64_t pesoMaximo = 0;
+    TipoFila escolhida = escolherFila(grafo, pesoMaximo);
+    // Radix e Dial só valem para pesos inteiros não negativos
+    if (tipo == TipoFila::AUTOMATICA || escolhida == TipoFila::HEAP4) {
+        tipo = escolhida;
+    }
+    if (tipo == TipoFila::DIAL && pesoMaximo > (std::uint64_t(1) << 24)) {
+        tipo = TipoFila::RADIX; // baldes demais para valer a pena
+    }
+    r.fila = tipo;
+
+    if (s >= 0 && s < tamanho) {
+        if (tipo == TipoFila::DIAL) {
+            FilaDial fila(tamanho, pesoMaximo);
+            executarDijkstra(grafo, s, fila, r);
+        } else if (tipo == TipoFila::RADIX) {
+            HeapRadix fila(tamanho);
+            executarDijkstra(grafo, s, fila, r);
+        } else {
+            HeapQuaternario fila(tamanho);
+            executarDijkstra(grafo, s, fila, r);
+        }
+    }
+
+    r.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return r;
+}
+
+inline void imprimirEstatisticas(const ResultadoDijkstra& r) {
+    std::cerr << "[dijkstra] fila=" << nomeFila(r.fila)
+              << " insercoes=" << r.contadores.insercoes
+              << " reducoes=" << r.contadores.reducoes
+              << " remocoes=" << r.contadores.remocoes
+              << " descartes=" << r.contadores.descartes
+              << " relaxamentos=" << r.relaxamentos
+              << " tempo=" << r.segundos * 1000.0 << " ms" << std::endl;
+}
+
+#endif
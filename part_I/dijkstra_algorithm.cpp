@@ -1,93 +1,124 @@
 #include <iostream>
 #include <vector>
-#include <queue>
 #include <limits>
 #include <algorithm>
-#include <unordered_map>
+#include <cstdlib>
 #include "grafo.hpp"
-
-struct Node {
-    int v;
-    double dist;
-    bool operator>(const Node& other) const {
-        return dist > other.dist;
-    }
-};
-
-std::unordered_map<int, double> dijkstra(const Grafo& grafo, int s, std::unordered_map<int, int>& antecessor) {
-    int n = grafo.qtdVertices();
-    std::unordered_map<int, double> dist;
-    antecessor.clear();
-
-    // Inicializa distâncias
-    for (int v = 1; v <= n; v++) {
-        dist[v] = std::numeric_limits<double>::infinity();
-        antecessor[v] = -1;
-    }
-    dist[s] = 0;
-
-    // Min-heap
-    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> pq;
-    pq.push({s, 0});
-
-    while (!pq.empty()) {
-        Node atual = pq.top();
-        pq.pop();
-        int u = atual.v;
-
-        // Relaxamento
-        for (int viz : grafo.vizinhos(u)) {
-            double peso = grafo.peso(u, viz);
-            if (dist[u] + peso < dist[viz]) {
-                dist[viz] = dist[u] + peso;
-                antecessor[viz] = u;
-                pq.push({viz, dist[viz]});
-            }
-        }
-    }
-
-    return dist;
-}
+#include "dijkstra.hpp"
+#include "ponto_a_ponto.hpp"
+#include "delta_stepping.hpp"
+#include "paralelo.hpp"
 
 // Reconstrói caminho de s até v usando antecessores
-std::vector<int> reconstruirCaminho(int v, const std::unordered_map<int, int>& antecessor) {
+std::vector<int> reconstruirCaminho(int v, const std::vector<int>& antecessor) {
     std::vector<int> caminho;
-    for (int atual = v; atual != -1; atual = antecessor.at(atual)) {
+    for (int atual = v; atual != -1; atual = antecessor[atual]) {
         caminho.push_back(atual);
     }
     std::reverse(caminho.begin(), caminho.end());
     return caminho;
 }
 
+void imprimirCaminho(int v, const std::vector<int>& caminho, double dist) {
+    std::cout << v << ": ";
+    for (size_t i = 0; i < caminho.size(); i++) {
+        if (i > 0) std::cout << ",";
+        std::cout << caminho[i];
+    }
+    std::cout << "; d=";
+    if (dist == std::numeric_limits<double>::infinity())
+        std::cout << "inf";
+    else
+        std::cout << dist;
+    std::cout << std::endl;
+}
+
+// Com GRAFO_ESTATISTICAS: repete o delta-stepping com 1, 2, 4, ... threads e mostra a eficiência
+void relatorioEscalabilidade(const Grafo& grafo, int s, unsigned maxThreads, double delta) {
+    double base = 0.0;
+    for (unsigned t = 1;; t = std::min(2 * t, maxThreads)) {
+        auto r = deltaStepping(grafo, s, t, delta);
+        if (t == 1) base = r.segundos;
+        std::cerr << "[delta] threads=" << t
+                  << " tempo=" << r.segundos * 1000.0 << " ms"
+                  << " aceleracao=" << base / r.segundos
+                  << " eficiencia=" << 100.0 * base / (r.segundos * t) << "%" << std::endl;
+        if (t == maxThreads) break;
+    }
+}
+
 int main(int argc, char* argv[]) {
-    if (argc != 3) {
-        std::cerr << "Uso: " << argv[0] << " <arquivo_grafo> <vertice_inicial>" << std::endl;
+    bool modoDelta = argc >= 4 && std::string(argv[3]) == "delta";
+    if (argc < 3 || argc > 5 || (argc == 5 && !modoDelta && std::string(argv[4]) != "alt")) {
+        std::cerr << "Uso: " << argv[0] << " <arquivo_grafo> <vertice_inicial> [<vertice_final> [alt]]" << std::endl;
+        std::cerr << "     " << argv[0] << " <arquivo_grafo> <vertice_inicial> delta [<threads>]" << std::endl;
         return 1;
     }
 
     std::string arquivo = argv[1];
     int s = std::stoi(argv[2]);
+    unsigned threads = 0;
+    if (modoDelta && argc == 5 && !lerThreads(argv[4], threads)) {
+        std::cerr << "Erro: número de threads inválido." << std::endl;
+        return 1;
+    }
 
     Grafo grafo(arquivo);
-    std::unordered_map<int, int> antecessor;
-    auto dist = dijkstra(grafo, s, antecessor);
+    grafo.compactar();
 
-    // Imprime saída no formato pedido
-    for (int v = 1; v <= grafo.qtdVertices(); v++) {
-        std::cout << v << ": ";
+    // Delta-stepping paralelo: mesma saída do Dijkstra. GRAFO_DELTA fixa a largura dos baldes.
+    if (modoDelta) {
+        const char* delta = std::getenv("GRAFO_DELTA");
+        auto resultado = deltaStepping(grafo, s, threads, delta ? std::atof(delta) : 0.0);
+        if (estatisticasAtivas()) {
+            std::cerr << "[delta] delta=" << resultado.delta
+                      << " threads=" << resultado.threads
+                      << " baldes=" << resultado.baldes
+                      << " rodadas=" << resultado.rodadas
+                      << " relaxamentos=" << resultado.relaxamentos
+                      << " tempo=" << resultado.segundos * 1000.0 << " ms" << std::endl;
+            relatorioEscalabilidade(grafo, s, resultado.threads, resultado.delta);
+        }
+        for (int v = 1; v <= grafo.qtdVertices(); v++) {
+            imprimirCaminho(v, reconstruirCaminho(v, resultado.antecessor), resultado.dist[v]);
+        }
+        return 0;
+    }
 
-        auto caminho = reconstruirCaminho(v, antecessor);
-        for (size_t i = 0; i < caminho.size(); i++) {
-            if (i > 0) std::cout << ",";
-            std::cout << caminho[i];
+    // Consulta ponto a ponto: bidirecional, ou A* com landmarks (<arquivo>.alt) se pedido
+    if (argc >= 4) {
+        int t = std::stoi(argv[3]);
+        ResultadoPontoAPonto r;
+        if (argc == 5) {
+            Landmarks lm = landmarksDoGrafo(grafo, arquivo);
+            r = aEstrelaALT(grafo, s, t, lm);
+        } else {
+            r = dijkstraBidirecional(grafo, s, t);
+        }
+        if (estatisticasAtivas()) {
+            std::cerr << "[dijkstra] " << (argc == 5 ? "alt" : "bidirecional")
+                      << " assentados=" << r.assentados
+                      << " tempo=" << r.segundos * 1000.0 << " ms" << std::endl;
         }
+        // Inalcançável: mesmo formato do modo de origem única ("t: t; d=inf")
+        if (r.caminho.empty()) r.caminho.push_back(t);
+        imprimirCaminho(t, r.caminho, r.dist);
+        return 0;
+    }
+
+    // GRAFO_FILA=heap4|radix|dial força a fila de prioridade (padrão: escolha pelos pesos)
+    const char* fila = std::getenv("GRAFO_FILA");
+    auto resultado = dijkstra(grafo, s, tipoFilaPorNome(fila ? fila : ""));
+    if (estatisticasAtivas()) {
+        imprimirEstatisticas(resultado);
+    }
+
+    const auto& dist = resultado.dist;
+    const auto& antecessor = resultado.antecessor;
 
-        std::cout << "; d=";
-        if (dist[v] == std::numeric_limits<double>::infinity())
-            std::cout << "inf";
-        else
-            std::cout << dist[v];
-        std::cout << std::endl;
+    // Imprime saída no formato pedido
+    for (int v = 1; v <= grafo.qtdVertices(); v++) {
+        imprimirCaminho(v, reconstruirCaminho(v, antecessor), dist[v]);
     }
 
     return 0;
@@ -0,0 +1,614 @@
+#ifndef EMPARELHAMENTO_HPP
+#define EMPARELHAMENTO_HPP
+
+// Emparelhamento perfeito de peso mínimo em grafo completo (métrico), para o carteiro chinês.
+//
+// O núcleo é o algoritmo primal-dual de Edmonds com blossoms (Galil, na organização
+// de Van Rantwijk), O(n³), para emparelhamento de peso máximo com cardinalidade máxima.
+// Peso mínimo vira peso máximo com w' = C - d, e os pesos são inteiros (distâncias
+// fracionárias são escalonadas para ponto fixo) para que as folgas sejam exatas.
+//
+// Em vez de dar ao Edmonds as k²/2 arestas do grafo completo, ele roda num subgrafo
+// com os vizinhos mais próximos de cada vértice. As variáveis duais do resultado são
+// então verificadas contra todos os pares, em paralelo; pares com folga negativa entram
+// no subgrafo e o Edmonds roda de novo. Quando nenhum par viola, as duais certificam
+// que o emparelhamento é ótimo também no grafo completo.
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include "paralelo.hpp"
+
+// Vizinhos mais próximos de cada vértice na primeira rodada
+const int EMPARELHAMENTO_VIZINHOS = 12;
+
+// Emparelhamento de peso máximo em grafo geral (Edmonds/Galil, versão de Van Rantwijk).
+// Vértices 0..n-1; arestas (i, j, w) com w inteiro. As duais ficam em escala 2x:
+// folga(i, j) = dual[i] + dual[j] - 2w + 2 * soma de dual[B] dos blossoms com i e j.
+class EmparelhamentoPesoMaximo {
+public:
+    struct Aresta {
+        int i, j;
+        std::int64_t w;
+    };
+
+private:
+    int n;
+    std::vector<Aresta> arestas;
+    std::vector<int> ponta;                  // ponta[p] = vértice da extremidade p (aresta p / 2)
+    std::vector<std::vector<int>> vizinhas;  // extremidades remotas das arestas de cada vértice
+    std::vector<int> par;                    // extremidade remota da aresta emparelhada, ou -1
+    std::vector<int> rotulo, rotuloPonta, noBlossom, paiBlossom, baseBlossom, melhorAresta;
+    std::vector<std::vector<int>> filhosBlossom, pontasBlossom, melhoresBlossom;
+    std::vector<bool> temMelhores;
+    std::vector<int> livres;
+    std::vector<std::int64_t> dual;
+    std::vector<char> permitida;
+    std::vector<int> fila;
+
+    std::int64_t folga(int k) const {
+        return dual[arestas[k].i] + dual[arestas[k].j] - 2 * arestas[k].w;
+    }
+
+    void folhas(int b, std::vector<int>& saida) const {
+        if (b < n) {
+            saida.push_back(b);
+            return;
+        }
+        for (int t : filhosBlossom[b]) folhas(t, saida);
+    }
+
+    void atribuirRotulo(int w, int t, int p) {
+        int b = noBlossom[w];
+        rotulo[w] = rotulo[b] = t;
+        rotuloPonta[w] = rotuloPonta[b] = p;
+        melhorAresta[w] = melhorAresta[b] = -1;
+        if (t == 1) {
+            folhas(b, fila);
+        } else if (t == 2) {
+            int base = baseBlossom[b];
+            atribuirRotulo(ponta[par[base]], 1, par[base] ^ 1);
+        }
+    }
+
+    // Sobe pelas árvores alternantes de v e w; devolve a base do novo blossom ou -1 (caminho aumentante)
+    int procurarBlossom(int v, int w) {
+        std::vector<int> caminho;
+        int base = -1;
+        while (v != -1 || w != -1) {
+            int b = noBlossom[v];
+            if (rotulo[b] & 4) {
+                base = baseBlossom[b];
+                break;
+            }
+            caminho.push_back(b);
+            rotulo[b] = 5;
+            if (rotuloPonta[b] == -1) {
+                v = -1;
+            } else {
+                v = ponta[rotuloPonta[b]];
+                b = noBlossom[v];
+                v = ponta[rotuloPonta[b]];
+            }
+            if (w != -1) std::swap(v, w);
+        }
+        for (int b : caminho) rotulo[b] = 1;
+        return base;
+    }
+
+    void adicionarBlossom(int base, int k) {
+        int v = arestas[k].i, w = arestas[k].j;
+        int bb = noBlossom[base], bv = noBlossom[v], bw = noBlossom[w];
+        int b = livres.back();
+        livres.pop_back();
+        baseBlossom[b] = base;
+        paiBlossom[b] = -1;
+        paiBlossom[bb] = b;
+        std::vector<int>& caminho = filhosBlossom[b];
+        std::vector<int>& pontas = pontasBlossom[b];
+        caminho.clear();
+        pontas.clear();
+        while (bv != bb) {
+            paiBlossom[bv] = b;
+            caminho.push_back(bv);
+            pontas.push_back(rotuloPonta[bv]);
+            v = ponta[rotuloPonta[bv]];
+            bv = noBlossom[v];
+        }
+        caminho.push_back(bb);
+        std::reverse(caminho.begin(), caminho.end());
+        std::reverse(pontas.begin(), pontas.end());
+        pontas.push_back(2 * k);
+        while (bw != bb) {
+            paiBlossom[bw] = b;
+            caminho.push_back(bw);
+            pontas.push_back(rotuloPonta[bw] ^ 1);
+            w = ponta[rotuloPonta[bw]];
+            bw = noBlossom[w];
+        }
+        rotulo[b] = 1;
+        rotuloPonta[b] = rotuloPonta[bb];
+        dual[b] = 0;
+        std::vector<int> vs;
+        folhas(b, vs);
+        for (int x : vs) {
+            if (rotulo[noBlossom[x]] == 2) fila.push_back(x);
+            noBlossom[x] = b;
+        }
+        // Melhor aresta do novo blossom para cada outro blossom S
+        std::vector<int> melhorPara(2 * n, -1);
+        for (int filho : caminho) {
+            std::vector<int> lista;
+            if (!temMelhores[filho]) {
+                vs.clear();
+                folhas(filho, vs);
+                for (int x : vs) {
+                    for (int p : vizinhas[x]) lista.push_back(p / 2);
+                }
+            } else {
+                lista = melhoresBlossom[filho];
+            }
+            for (int kk : lista) {
+                int i = arestas[kk].i, j = arestas[kk].j;
+                if (noBlossom[j] == b) std::swap(i, j);
+                int bj = noBlossom[j];
+                if (bj != b && rotulo[bj] == 1 && (melhorPara[bj] == -1 || folga(kk) < folga(melhorPara[bj]))) {
+                    melhorPara[bj] = kk;
+                }
+            }
+            melhoresBlossom[filho].clear();
+            temMelhores[filho] = false;
+            melhorAresta[filho] = -1;
+        }
+        melhoresBlossom[b].clear();
+        for (int kk : melhorPara) {
+            if (kk != -1) melhoresBlossom[b].push_back(kk);
+        }
+        temMelhores[b] = true;
+        melhorAresta[b] = -1;
+        for (int kk : melhoresBlossom[b]) {
+            if (melhorAresta[b] == -1 || folga(kk) < folga(melhorAresta[b])) melhorAresta[b] = kk;
+        }
+    }
+
+    void expandirBlossom(int b, bool fimEtapa) {
+        for (int s : filhosBlossom[b]) {
+            paiBlossom[s] = -1;
+            if (s < n) {
+                noBlossom[s] = s;
+            } else if (fimEtapa && dual[s] == 0) {
+                expandirBlossom(s, fimEtapa);
+            } else {
+                std::vector<int> vs;
+                folhas(s, vs);
+                for (int x : vs) noBlossom[x] = s;
+            }
+        }
+        if (!fimEtapa && rotulo[b] == 2) {
+            // Reetiqueta os sub-blossoms no caminho par de entrada até a base
+            const std::vector<int>& filhos = filhosBlossom[b];
+            const std::vector<int>& pontas = pontasBlossom[b];
+            int tam = filhos.size();
+            int entrada = noBlossom[ponta[rotuloPonta[b] ^ 1]];
+            int j = std::find(filhos.begin(), filhos.end(), entrada) - filhos.begin();
+            int passo, truque;
+            if (j & 1) {
+                j -= tam;
+                passo = 1;
+                truque = 0;
+            } else {
+                passo = -1;
+                truque = 1;
+            }
+            auto em = [tam](const std::vector<int>& lista, int idx) { return lista[((idx % tam) + tam) % tam]; };
+            int p = rotuloPonta[b];
+            while (j != 0) {
+                rotulo[ponta[p ^ 1]] = 0;
+                rotulo[ponta[em(pontas, j - truque) ^ truque ^ 1]] = 0;
+                atribuirRotulo(ponta[p ^ 1], 2, p);
+                permitida[em(pontas, j - truque) / 2] = 1;
+                j += passo;
+                p = em(pontas, j - truque) ^ truque;
+                permitida[p / 2] = 1;
+                j += passo;
+            }
+            int bv = em(filhos, j);
+            rotulo[ponta[p ^ 1]] = rotulo[bv] = 2;
+            rotuloPonta[ponta[p ^ 1]] = rotuloPonta[bv] = p;
+            melhorAresta[bv] = -1;
+            j += passo;
+            while (em(filhos, j) != entrada) {
+                bv = em(filhos, j);
+                if (rotulo[bv] == 1) {
+                    j += passo;
+                    continue;
+                }
+                std::vector<int> vs;
+                folhas(bv, vs);
+                int rotulado = -1;
+                for (int x : vs) {
+                    if (rotulo[x] != 0) {
+                        rotulado = x;
+                        break;
+                    }
+                }
+                if (rotulado != -1) {
+                    rotulo[rotulado] = 0;
+                    rotulo[ponta[par[baseBlossom[bv]]]] = 0;
+                    atribuirRotulo(rotulado, 2, rotuloPonta[rotulado]);
+                }
+                j += passo;
+            }
+        }
+        rotulo[b] = rotuloPonta[b] = -1;
+        filhosBlossom[b].clear();
+        pontasBlossom[b].clear();
+        baseBlossom[b] = -1;
+        melhoresBlossom[b].clear();
+        temMelhores[b] = false;
+        melhorAresta[b] = -1;
+        livres.push_back(b);
+    }
+
+    // Troca arestas emparelhadas dentro de b para que v vire a base
+    void aumentarBlossom(int b, int v) {
+        int t = v;
+        while (paiBlossom[t] != b) t = paiBlossom[t];
+        if (t >= n) aumentarBlossom(t, v);
+        std::vector<int>& filhos = filhosBlossom[b];
+        std::vector<int>& pontas = pontasBlossom[b];
+        int tam = filhos.size();
+        int i = std::find(filhos.begin(), filhos.end(), t) - filhos.begin();
+        int j = i;
+        int passo, truque;
+        if (i & 1) {
+            j -= tam;
+            passo = 1;
+            truque = 0;
+        } else {
+            passo = -1;
+            truque = 1;
+        }
+        auto em = [tam](const std::vector<int>& lista, int idx) { return lista[((idx % tam) + tam) % tam]; };
+        while (j != 0) {
+            j += passo;
+            t = em(filhos, j);
+            int p = em(pontas, j - truque) ^ truque;
+            if (t >= n) aumentarBlossom(t, ponta[p]);
+            j += passo;
+            t = em(filhos, j);
+            if (t >= n) aumentarBlossom(t, ponta[p ^ 1]);
+            par[ponta[p]] = p ^ 1;
+            par[ponta[p ^ 1]] = p;
+        }
+        std::rotate(filhos.begin(), filhos.begin() + i, filhos.end());
+        std::rotate(pontas.begin(), pontas.begin() + i, pontas.end());
+        baseBlossom[b] = baseBlossom[filhos[0]];
+    }
+
+    void aumentarEmparelhamento(int k) {
+        int extremos[2][2] = {{arestas[k].i, 2 * k + 1}, {arestas[k].j, 2 * k}};
+        for (auto& e : extremos) {
+            int s = e[0], p = e[1];
+            while (true) {
+                int bs = noBlossom[s];
+                if (bs >= n) aumentarBlossom(bs, s);
+                par[s] = p;
+                if (rotuloPonta[bs] == -1) break;
+                int t = ponta[rotuloPonta[bs]];
+                int bt = noBlossom[t];
+                s = ponta[rotuloPonta[bt]];
+                int j = ponta[rotuloPonta[bt] ^ 1];
+                if (bt >= n) aumentarBlossom(bt, j);
+                par[j] = rotuloPonta[bt];
+                p = rotuloPonta[bt] ^ 1;
+            }
+        }
+    }
+
+public:
+    EmparelhamentoPesoMaximo(int numVertices, std::vector<Aresta> lista)
+        : n(numVertices), arestas(std::move(lista)) {}
+
+    // Parceiro de cada vértice (-1 se livre). Com maxCardinalidade, o de peso máximo
+    // entre os de cardinalidade máxima.
+    std::vector<int> resolver(bool maxCardinalidade) {
+        int m = arestas.size();
+        std::int64_t pesoMaximo = 0;
+        for (const Aresta& a : arestas) pesoMaximo = std::max(pesoMaximo, a.w);
+        ponta.resize(2 * m);
+        vizinhas.assign(n, {});
+        for (int k = 0; k < m; k++) {
+            ponta[2 * k] = arestas[k].i;
+            ponta[2 * k + 1] = arestas[k].j;
+            vizinhas[arestas[k].i].push_back(2 * k + 1);
+            vizinhas[arestas[k].j].push_back(2 * k);
+        }
+        par.assign(n, -1);
+        rotulo.assign(2 * n, 0);
+        rotuloPonta.assign(2 * n, -1);
+        noBlossom.resize(n);
+        for (int v = 0; v < n; v++) noBlossom[v] = v;
+        paiBlossom.assign(2 * n, -1);
+        filhosBlossom.assign(2 * n, {});
+        pontasBlossom.assign(2 * n, {});
+        baseBlossom.assign(2 * n, -1);
+        for (int v = 0; v < n; v++) baseBlossom[v] = v;
+        melhorAresta.assign(2 * n, -1);
+        melhoresBlossom.assign(2 * n, {});
+        temMelhores.assign(2 * n, false);
+        livres.clear();
+        for (int b = 2 * n - 1; b >= n; b--) livres.push_back(b);
+        dual.assign(2 * n, 0);
+        for (int v = 0; v < n; v++) dual[v] = pesoMaximo;
+        permitida.assign(m, 0);
+
+        for (int etapa = 0; etapa < n; etapa++) {
+            std::fill(rotulo.begin(), rotulo.end(), 0);
+            std::fill(melhorAresta.begin(), melhorAresta.end(), -1);
+            for (int b = n; b < 2 * n; b++) {
+                melhoresBlossom[b].clear();
+                temMelhores[b] = false;
+            }
+            std::fill(permitida.begin(), permitida.end(), 0);
+            fila.clear();
+            for (int v = 0; v < n; v++) {
+                if (par[v] == -1 && rotulo[noBlossom[v]] == 0) atribuirRotulo(v, 1, -1);
+            }
+
+            bool aumentou = false;
+            while (true) {
+                while (!fila.empty() && !aumentou) {
+                    int v = fila.back();
+                    fila.pop_back();
+                    for (int p : vizinhas[v]) {
+                        int k = p / 2;
+                        int w = ponta[p];
+                        if (noBlossom[v] == noBlossom[w]) continue;
+                        std::int64_t folgaK = 0;
+                        if (!permitida[k]) {
+                            folgaK = folga(k);
+                            if (folgaK <= 0) permitida[k] = 1;
+                        }
+                        if (permitida[k]) {
+                            if (rotulo[noBlossom[w]] == 0) {
+                                atribuirRotulo(w, 2, p ^ 1);
+                            } else if (rotulo[noBlossom[w]] == 1) {
+                                int base = procurarBlossom(v, w);
+                                if (base >= 0) {
+                                    adicionarBlossom(base, k);
+                                } else {
+                                    aumentarEmparelhamento(k);
+                                    aumentou = true;
+                                    break;
+                                }
+                            } else if (rotulo[w] == 0) {
+                                rotulo[w] = 2;
+                                rotuloPonta[w] = p ^ 1;
+                            }
+                        } else if (rotulo[noBlossom[w]] == 1) {
+                            int b = noBlossom[v];
+                            if (melhorAresta[b] == -1 || folgaK < folga(melhorAresta[b])) melhorAresta[b] = k;
+                        } else if (rotulo[w] == 0) {
+                            if (melhorAresta[w] == -1 || folgaK < folga(melhorAresta[w])) melhorAresta[w] = k;
+                        }
+                    }
+                }
+                if (aumentou) break;
+
+                // Passo dual: o menor delta que torna uma aresta utilizável ou expande um blossom
+                int tipo = -1;
+                std::int64_t delta = 0;
+                int arestaDelta = -1, blossomDelta = -1;
+                if (!maxCardinalidade) {
+                    tipo = 1;
+                    delta = *std::min_element(dual.begin(), dual.begin() + n);
+                }
+                for (int v = 0; v < n; v++) {
+                    if (rotulo[noBlossom[v]] == 0 && melhorAresta[v] != -1) {
+                        std::int64_t d = folga(melhorAresta[v]);
+                        if (tipo == -1 || d < delta) {
+                            delta = d;
+                            tipo = 2;
+                            arestaDelta = melhorAresta[v];
+                        }
+                    }
+                }
+                for (int b = 0; b < 2 * n; b++) {
+                    if (paiBlossom[b] == -1 && rotulo[b] == 1 && melhorAresta[b] != -1) {
+                        std::int64_t d = folga(melhorAresta[b]) / 2;
+                        if (tipo == -1 || d < delta) {
+                            delta = d;
+                            tipo = 3;
+                            arestaDelta = melhorAresta[b];
+                        }
+                    }
+                }
+                for (int b = n; b < 2 * n; b++) {
+                    if (baseBlossom[b] >= 0 && paiBlossom[b] == -1 && rotulo[b] == 2 &&
+                        (tipo == -1 || dual[b] < delta)) {
+                        delta = dual[b];
+                        tipo = 4;
+                        blossomDelta = b;
+                    }
+                }
+                if (tipo == -1) {
+                    tipo = 1;
+                    delta = std::max<std::int64_t>(0, *std::min_element(dual.begin(), dual.begin() + n));
+                }
+
+                for (int v = 0; v < n; v++) {
+                    if (rotulo[noBlossom[v]] == 1) {
+                        dual[v] -= delta;
+                    } else if (rotulo[noBlossom[v]] == 2) {
+                        dual[v] += delta;
+                    }
+                }
+                for (int b = n; b < 2 * n; b++) {
+                    if (baseBlossom[b] >= 0 && paiBlossom[b] == -1) {
+                        if (rotulo[b] == 1) {
+                            dual[b] += delta;
+                        } else if (rotulo[b] == 2) {
+                            dual[b] -= delta;
+                        }
+                    }
+                }
+
+                if (tipo == 1) {
+                    break;
+                } else if (tipo == 2) {
+                    permitida[arestaDelta] = 1;
+                    int i = arestas[arestaDelta].i, j = arestas[arestaDelta].j;
+                    if (rotulo[noBlossom[i]] == 0) std::swap(i, j);
+                    fila.push_back(i);
+                } else if (tipo == 3) {
+                    permitida[arestaDelta] = 1;
+                    fila.push_back(arestas[arestaDelta].i);
+                } else {
+                    expandirBlossom(blossomDelta, false);
+                }
+            }
+            if (!aumentou) break;
+
+            // Fim da etapa: blossoms S de dual zero viram vértices soltos de novo
+            for (int b = n; b < 2 * n; b++) {
+                if (paiBlossom[b] == -1 && baseBlossom[b] >= 0 && rotulo[b] == 1 && dual[b] == 0) {
+                    expandirBlossom(b, true);
+                }
+            }
+        }
+
+        std::vector<int> parceiro(n, -1);
+        for (int v = 0; v < n; v++) {
+            if (par[v] >= 0) parceiro[v] = ponta[par[v]];
+        }
+        return parceiro;
+    }
+
+    // Folga de (i, j) com peso w, contando os blossoms que contêm os dois (escala 2x)
+    std::int64_t folgaPar(int i, int j, std::int64_t w) const {
+        std::int64_t f = dual[i] + dual[j] - 2 * w;
+        // Ancestrais de i marcados pela profundidade a partir do topo
+        for (int a = paiBlossom[i]; a != -1; a = paiBlossom[a]) {
+            for (int c = paiBlossom[j]; c != -1; c = paiBlossom[c]) {
+                if (c == a) {
+                    // a e todos os seus ancestrais contêm i e j
+                    for (int x = a; x != -1; x = paiBlossom[x]) f += 2 * dual[x];
+                    return f;
+                }
+            }
+        }
+        return f;
+    }
+
+    // Blossom de nível mais alto que contém v (v mesmo se nenhum)
+    int blossomTopo(int v) const {
+        while (paiBlossom[v] != -1) v = paiBlossom[v];
+        return v;
+    }
+};
+
+// Emparelhamento perfeito de peso mínimo entre k vértices, com dist[i * k + j] simétrica
+// (infinito = par inalcançável). Devolve o parceiro de cada um, ou vazio se não houver
+// emparelhamento perfeito. rodadas recebe quantas vezes o Edmonds rodou.
+inline std::vector<int> emparelhamentoPerfeitoMinimo(const std::vector<double>& dist, int k,
+                                                     unsigned numThreads, int& rodadas) {
+    using Aresta = EmparelhamentoPesoMaximo::Aresta;
+    numThreads = threadsEfetivas(numThreads);
+    rodadas = 0;
+    if (k == 0) return {};
+    if (k % 2 != 0) return {};
+
+    // Pesos inteiros: distâncias inteiras ficam exatas; as outras viram ponto fixo
+    double maior = 0;
+    bool inteiras = true;
+    for (double d : dist) {
+        if (d == std::numeric_limits<double>::infinity()) continue;
+        maior = std::max(maior, d);
+        if (d != std::floor(d)) inteiras = false;
+    }
+    double escala = 1;
+    if (!inteiras || maior > 1e15) {
+        escala = std::ldexp(1.0, 40 - std::max(0, std::ilogb(std::max(maior, 1.0)) + 1));
+    }
+    std::int64_t teto = static_cast<std::int64_t>(std::llround(maior * escala)) + 1;
+    auto peso = [&](int i, int j) {
+        return teto - static_cast<std::int64_t>(std::llround(dist[static_cast<std::size_t>(i) * k + j] * escala));
+    };
+    auto alcancavel = [&](int i, int j) {
+        return dist[static_cast<std::size_t>(i) * k + j] != std::numeric_limits<double>::infinity();
+    };
+
+    // Subgrafo inicial: os EMPARELHAMENTO_VIZINHOS mais próximos de cada vértice
+    std::vector<std::vector<int>> candidatos(k);
+    emFaixas(k, numThreads, [&](int inicio, int fim) {
+        std::vector<int> ordem;
+        for (int i = inicio; i < fim; i++) {
+            ordem.clear();
+            for (int j = 0; j < k; j++) {
+                if (j != i && alcancavel(i, j)) ordem.push_back(j);
+            }
+            std::size_t q = std::min<std::size_t>(ordem.size(), EMPARELHAMENTO_VIZINHOS);
+            std::nth_element(ordem.begin(), ordem.begin() + q - (q > 0), ordem.end(), [&](int a, int b) {
+                return dist[static_cast<std::size_t>(i) * k + a] < dist[static_cast<std::size_t>(i) * k + b];
+            });
+            candidatos[i].assign(ordem.begin(), ordem.begin() + q);
+        }
+    });
+    std::vector<std::pair<int, int>> pares;
+    for (int i = 0; i < k; i++) {
+        for (int j : candidatos[i]) pares.push_back({std::min(i, j), std::max(i, j)});
+    }
+
+    while (true) {
+        std::sort(pares.begin(), pares.end());
+        pares.erase(std::unique(pares.begin(), pares.end()), pares.end());
+        std::vector<Aresta> lista;
+        lista.reserve(pares.size());
+        for (const auto& pr : pares) lista.push_back({pr.first, pr.second, peso(pr.first, pr.second)});
+
+        EmparelhamentoPesoMaximo edmonds(k, std::move(lista));
+        std::vector<int> parceiro = edmonds.resolver(true);
+        rodadas++;
+
+        bool perfeito = std::find(parceiro.begin(), parceiro.end(), -1) == parceiro.end();
+        if (!perfeito) {
+            // O subgrafo não tem emparelhamento perfeito: se já é o completo, não existe
+            if (pares.size() == static_cast<std::size_t>(k) * (k - 1) / 2) return {};
+            std::size_t antes = pares.size();
+            for (int i = 0; i < k; i++) {
+                if (parceiro[i] != -1) continue;
+                for (int j = 0; j < k; j++) {
+                    if (j != i && alcancavel(i, j)) pares.push_back({std::min(i, j), std::max(i, j)});
+                }
+            }
+            std::sort(pares.begin(), pares.end());
+            pares.erase(std::unique(pares.begin(), pares.end()), pares.end());
+            if (pares.size() == antes) return {};
+            continue;
+        }
+
+        // Preço: procura pares fora do subgrafo com folga negativa, em paralelo
+        std::vector<std::pair<int, int>> violados;
+        std::mutex trava;
+        emFaixas(k, numThreads, [&](int inicio, int fim) {
+            std::vector<std::pair<int, int>> meus;
+            for (int i = inicio; i < fim; i++) {
+                for (int j = i + 1; j < k; j++) {
+                    if (!alcancavel(i, j)) continue;
+                    if (edmonds.folgaPar(i, j, peso(i, j)) < 0) meus.push_back({i, j});
+                }
+            }
+            std::lock_guard<std::mutex> bloqueio(trava);
+            violados.insert(violados.end(), meus.begin(), meus.end());
+        });
+        if (violados.empty()) return parceiro;
+        pares.insert(pares.end(), violados.begin(), violados.end());
+    }
+}
+
+#endif
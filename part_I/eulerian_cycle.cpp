@@ -1,134 +1,90 @@
 #include <iostream>
 #include <vector>
-#include <unordered_map>
-#include <unordered_set>
-#include <stack>
-#include <algorithm>
+#include <string>
+#include <charconv>
 #include "grafo.hpp"
+#include "ciclo_euleriano.hpp"
+#include "carteiro_chines.hpp"
+#include "paralelo.hpp"
 
-bool temCicloEuleriano(const Grafo& grafo) {
-    std::vector<int> vertices = grafo.getTodosVertices();
-    
-    // Verifica se todos os vértices têm grau par
-    for (int v : vertices) {
-        if (grafo.grau(v) % 2 != 0) {
-            return false;
-        }
-    }
-    
-    // Verifica conectividade usando DFS
-    if (vertices.empty()) return false;
-    
-    std::unordered_set<int> visitados;
-    std::stack<int> pilha;
-    pilha.push(vertices[0]);
-    
-    while (!pilha.empty()) {
-        int v = pilha.top();
-        pilha.pop();
-        
-        if (visitados.find(v) != visitados.end()) {
-            continue;
-        }
-        
-        visitados.insert(v);
-        
-        for (int vizinho : grafo.vizinhos(v)) {
-            if (visitados.find(vizinho) == visitados.end()) {
-                pilha.push(vizinho);
-            }
-        }
-    }
-    
-    // Verifica se todos os vértices com grau > 0 foram visitados
-    for (int v : vertices) {
-        if (grafo.grau(v) > 0 && visitados.find(v) == visitados.end()) {
-            return false;
-        }
-    }
-    
-    return true;
-}
+// Bytes acumulados antes de cada escrita em stdout
+const std::size_t TAMANHO_BLOCO_SAIDA = 1 << 20;
 
-std::vector<int> encontrarCicloEuleriano(const Grafo& grafo) {
-    if (!temCicloEuleriano(grafo)) {
-        return {};
-    }
-    
-    // Cria cópia das adjacências para remover arestas
-    std::unordered_map<int, std::vector<int>> adj_copy;
-    std::vector<int> vertices = grafo.getTodosVertices();
-    
-    for (int v : vertices) {
-        adj_copy[v] = grafo.vizinhos(v);
-    }
-    
-    // Encontra vértice inicial (qualquer um com grau > 0)
-    int inicio = -1;
-    for (int v : vertices) {
-        if (!adj_copy[v].empty()) {
-            inicio = v;
-            break;
-        }
-    }
-    
-    if (inicio == -1) {
-        return {};
-    }
-    
-    std::stack<int> pilha;
-    std::vector<int> ciclo;
-    pilha.push(inicio);
-    
-    while (!pilha.empty()) {
-        int v = pilha.top();
-        
-        if (!adj_copy[v].empty()) {
-            // Pega próximo vizinho
-            int u = adj_copy[v].back();
-            adj_copy[v].pop_back();
-            
-            // Remove aresta u-v também
-            auto it = std::find(adj_copy[u].begin(), adj_copy[u].end(), v);
-            if (it != adj_copy[u].end()) {
-                adj_copy[u].erase(it);
+// O ciclo sai em blocos, à medida que o Hierholzer o produz. O último vértice
+// (igual ao primeiro) não é impresso, então cada um só sai quando chega o próximo.
+void imprimirCiclo(MotorEuler& motor, int inicio) {
+    std::string saida;
+    saida.reserve(TAMANHO_BLOCO_SAIDA + 16);
+    int pendente = -1;
+    bool primeiro = true;
+    char numero[16];
+    motor.percorrer(inicio, [&](int v) {
+        if (pendente >= 0) {
+            if (!primeiro) saida += ',';
+            primeiro = false;
+            auto r = std::to_chars(numero, numero + sizeof numero, pendente);
+            saida.append(numero, r.ptr);
+            if (saida.size() >= TAMANHO_BLOCO_SAIDA) {
+                std::cout.write(saida.data(), saida.size());
+                saida.clear();
             }
-            
-            pilha.push(u);
-        } else {
-            // Não há mais arestas, adiciona ao ciclo
-            ciclo.push_back(pilha.top());
-            pilha.pop();
         }
-    }
-    
-    std::reverse(ciclo.begin(), ciclo.end());
-    return ciclo;
+        pendente = v;
+    });
+    saida += '\n';
+    std::cout.write(saida.data(), saida.size());
+    std::cout.flush();
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
+    bool modoCarteiro = argc >= 3 && std::string(argv[2]) == "carteiro";
+    if (argc < 2 || argc > 4 || (argc >= 3 && !modoCarteiro)) {
         std::cerr << "Uso: " << argv[0] << " <arquivo_grafo>" << std::endl;
+        std::cerr << "     " << argv[0] << " <arquivo_grafo> carteiro [<threads>]" << std::endl;
         return 1;
     }
     
     std::string arquivo = argv[1];
-    
+    unsigned threads = 0;
+    if (modoCarteiro && argc == 4 && !lerThreads(argv[3], threads)) {
+        std::cerr << "Erro: número de threads inválido." << std::endl;
+        return 1;
+    }
+
     Grafo grafo(arquivo);
+    grafo.compactar();
+
+    // Carteiro chinês: menor passeio fechado que cobre todas as arestas, repetindo as
+    // do emparelhamento dos vértices ímpares
+    if (modoCarteiro) {
+        auto resultado = carteiroChines(grafo, threads);
+        if (estatisticasAtivas()) {
+            std::cerr << "[carteiro] impares=" << resultado.impares
+                      << " duplicadas=" << resultado.arestasDuplicadas
+                      << " custo_original=" << resultado.custoOriginal
+                      << " custo_extra=" << resultado.custoExtra
+                      << " custo_total=" << resultado.custoTotal()
+                      << " rodadas_emparelhamento=" << resultado.rodadasEmparelhamento
+                      << " distancias=" << resultado.segundosDistancias * 1000.0 << " ms"
+                      << " emparelhamento=" << resultado.segundosEmparelhamento * 1000.0 << " ms"
+                      << " caminhos=" << resultado.segundosCaminhos * 1000.0 << " ms" << std::endl;
+        }
+        if (!resultado.possivel) {
+            std::cout << "0" << std::endl;
+            return 0;
+        }
+        std::cout << "1" << std::endl;
+        imprimirCiclo(*resultado.rota, resultado.inicio);
+        return 0;
+    }
     
-    std::vector<int> ciclo = encontrarCicloEuleriano(grafo);
-    
-    if (ciclo.empty()) {
+    MotorEuler motor(grafo);
+    if (!motor.temCicloEuleriano()) {
         std::cout << "0" << std::endl;
-    } else {
-        std::cout << "1" << std::endl;
-        for (size_t i = 0; i < ciclo.size() - 1; i++) {
-            if (i > 0) std::cout << ",";
-            std::cout << ciclo[i];
-        }
-        std::cout << std::endl;
+        return 0;
     }
+    std::cout << "1" << std::endl;
+    imprimirCiclo(motor, motor.primeiroComAresta());
     
     return 0;
 }
-
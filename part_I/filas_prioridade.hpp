@@ -0,0 +1,281 @@
+#ifndef FILAS_PRIORIDADE_HPP
+#define FILAS_PRIORIDADE_HPP
+
+// Filas de prioridade indexadas por vértice (0..n-1) para o Dijkstra.
+// Todas têm a mesma interface:
+//   bool vazia() const
+//   void inserirOuReduzir(int v, Chave k)   insere v ou reduz sua chave (ignora se k não for menor)
+//   int  removerMinimo()                    remove e devolve o vértice de menor chave
+// e contam as operações em `contadores`.
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+
+struct ContadoresFila {
+    std::uint64_t insercoes = 0;
+    std::uint64_t reducoes = 0;   // decrease-key (ou reinserção, nas filas preguiçosas)
+    std::uint64_t remocoes = 0;
+    std::uint64_t descartes = 0;  // entradas obsoletas jogadas fora sem processar
+};
+
+// Heap 4-ário indexado com decrease-key: cada vértice aparece no máximo uma vez,
+// então nenhuma entrada obsoleta chega a ser removida.
+class HeapQuaternario {
+public:
+    using Chave = double;
+
+private:
+    std::vector<int> heap;
+    std::vector<double> chave;
+    std::vector<int> posicao; // -1 = fora do heap
+
+    void colocar(int i, int v) {
+        heap[i] = v;
+        posicao[v] = i;
+    }
+
+    void subir(int i) {
+        int v = heap[i];
+        double k = chave[v];
+        while (i > 0) {
+            int pai = (i - 1) / 4;
+            if (chave[heap[pai]] <= k) break;
+            colocar(i, heap[pai]);
+            i = pai;
+        }
+        colocar(i, v);
+    }
+
+    void descer(int i) {
+        int n = heap.size();
+        int v = heap[i];
+        double k = chave[v];
+        while (true) {
+            int primeiro = 4 * i + 1;
+            if (primeiro >= n) break;
+            int menor = primeiro;
+            int ultimo = std::min(primeiro + 4, n);
+            for (int f = primeiro + 1; f < ultimo; f++) {
+                if (chave[heap[f]] < chave[heap[menor]]) menor = f;
+            }
+            if (chave[heap[menor]] >= k) break;
+            colocar(i, heap[menor]);
+            i = menor;
+        }
+        colocar(i, v);
+    }
+
+public:
+    ContadoresFila contadores;
+
+    explicit HeapQuaternario(int tamanho)
+        : chave(tamanho, std::numeric_limits<double>::infinity()), posicao(tamanho, -1) {}
+
+    bool vazia() const {
+        return heap.empty();
+    }
+
+    // Chave do topo (requer !vazia())
+    double chaveMinima() const {
+        return chave[heap[0]];
+    }
+
+    // Esvazia em O(tamanho atual), para reaproveitar o heap entre consultas
+    void limpar() {
+        for (int v : heap) posicao[v] = -1;
+        heap.clear();
+    }
+
+    void inserirOuReduzir(int v, double k) {
+        if (posicao[v] < 0) {
+            chave[v] = k;
+            heap.push_back(v);
+            posicao[v] = heap.size() - 1;
+            contadores.insercoes++;
+        } else {
+            if (k >= chave[v]) return;
+            chave[v] = k;
+            contadores.reducoes++;
+        }
+        subir(posicao[v]);
+    }
+
+    int removerMinimo() {
+        int v = heap[0];
+        posicao[v] = -1;
+        int ultimo = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            colocar(0, ultimo);
+            descer(0);
+        }
+        contadores.remocoes++;
+        return v;
+    }
+};
+
+// Radix heap (Ahuja-Mehlhorn-Orlin-Tarjan) para chaves inteiras não negativas e
+// monótonas, como as distâncias do Dijkstra com pesos inteiros >= 0.
+// O balde i guarda chaves cujo bit mais alto diferente de `ultima` é o bit i-1.
+// Reduções são inserções preguiçosas; a entrada antiga é descartada ao aparecer.
+class HeapRadix {
+public:
+    using Chave = std::uint64_t;
+
+private:
+    std::vector<std::pair<std::uint64_t, int>> baldes[65];
+    std::vector<std::uint64_t> chave; // chave vigente de cada vértice na fila
+    std::vector<char> naFila;
+    std::uint64_t ultima;             // última chave removida
+    std::size_t tamanho;              // entradas vivas
+
+    int balde(std::uint64_t k) const {
+        return k == ultima ? 0 : 64 - __builtin_clzll(k ^ ultima);
+    }
+
+    bool viva(const std::pair<std::uint64_t, int>& e) const {
+        return naFila[e.second] && chave[e.second] == e.first;
+    }
+
+public:
+    ContadoresFila contadores;
+
+    explicit HeapRadix(int n) : chave(n, 0), naFila(n, 0), ultima(0), tamanho(0) {}
+
+    bool vazia() const {
+        return tamanho == 0;
+    }
+
+    void inserirOuReduzir(int v, std::uint64_t k) {
+        if (!naFila[v]) {
+            naFila[v] = 1;
+            tamanho++;
+            contadores.insercoes++;
+        } else {
+            if (k >= chave[v]) return;
+            contadores.reducoes++;
+        }
+        chave[v] = k;
+        baldes[balde(k)].push_back({k, v});
+    }
+
+    int removerMinimo() {
+        while (true) {
+            if (baldes[0].empty()) {
+                // Acha o primeiro balde não vazio e redistribui a partir do menor valor vivo dele
+                int i = 1;
+                while (baldes[i].empty()) i++;
+                std::uint64_t menor = std::numeric_limits<std::uint64_t>::max();
+                bool achou = false;
+                for (const auto& e : baldes[i]) {
+                    if (viva(e) && e.first <= menor) {
+                        menor = e.first;
+                        achou = true;
+                    }
+                }
+                if (!achou) {
+                    contadores.descartes += baldes[i].size();
+                    baldes[i].clear();
+                    continue;
+                }
+                ultima = menor;
+                std::vector<std::pair<std::uint64_t, int>> redistribuir;
+                redistribuir.swap(baldes[i]);
+                for (const auto& e : redistribuir) {
+                    if (!viva(e)) {
+                        contadores.descartes++;
+                        continue;
+                    }
+                    baldes[balde(e.first)].push_back(e);
+                }
+            }
+
+            auto e = baldes[0].back();
+            baldes[0].pop_back();
+            if (!viva(e)) {
+                contadores.descartes++;
+                continue;
+            }
+            naFila[e.second] = 0;
+            tamanho--;
+            contadores.remocoes++;
+            return e.second;
+        }
+    }
+};
+
+// Baldes de Dial para pesos inteiros pequenos (0..C): C + 1 baldes circulares,
+// cada um uma lista duplamente encadeada intrusiva, com decrease-key em O(1).
+class FilaDial {
+public:
+    using Chave = std::uint64_t;
+
+private:
+    std::vector<int> primeiro;         // cabeça de cada balde
+    std::vector<int> proximo;
+    std::vector<int> anterior;
+    std::vector<std::uint64_t> chave;
+    std::vector<char> naFila;
+    std::uint64_t atual;               // menor chave possível na fila
+    std::size_t tamanho;
+
+    std::size_t indice(std::uint64_t k) const {
+        return k % primeiro.size();
+    }
+
+    void ligar(int v) {
+        std::size_t b = indice(chave[v]);
+        anterior[v] = -1;
+        proximo[v] = primeiro[b];
+        if (primeiro[b] >= 0) anterior[primeiro[b]] = v;
+        primeiro[b] = v;
+    }
+
+    void desligar(int v) {
+        if (anterior[v] >= 0) {
+            proximo[anterior[v]] = proximo[v];
+        } else {
+            primeiro[indice(chave[v])] = proximo[v];
+        }
+        if (proximo[v] >= 0) anterior[proximo[v]] = anterior[v];
+    }
+
+public:
+    ContadoresFila contadores;
+
+    FilaDial(int n, std::uint64_t pesoMaximo)
+        : primeiro(pesoMaximo + 1, -1), proximo(n, -1), anterior(n, -1), chave(n, 0),
+          naFila(n, 0), atual(0), tamanho(0) {}
+
+    bool vazia() const {
+        return tamanho == 0;
+    }
+
+    void inserirOuReduzir(int v, std::uint64_t k) {
+        if (naFila[v]) {
+            if (k >= chave[v]) return;
+            desligar(v);
+            contadores.reducoes++;
+        } else {
+            naFila[v] = 1;
+            tamanho++;
+            contadores.insercoes++;
+        }
+        chave[v] = k;
+        ligar(v);
+    }
+
+    int removerMinimo() {
+        while (primeiro[indice(atual)] < 0) atual++;
+        int v = primeiro[indice(atual)];
+        desligar(v);
+        naFila[v] = 0;
+        tamanho--;
+        contadores.remocoes++;
+        return v;
+    }
+};
+
+#endif
@@ -1,87 +1,129 @@
 #include <iostream>
 #include <vector>
-#include <unordered_map>
+#include <string>
 #include <limits>
-#include <algorithm>
-#include <iomanip>
+#include <chrono>
+#include <charconv>
+#include <cstdlib>
 #include "grafo.hpp"
+#include "floyd_warshall.hpp"
+#include "johnson.hpp"
+#include "paralelo.hpp"
 
-std::vector<std::vector<double>> floydWarshall(const Grafo& grafo) {
-    std::vector<int> vertices = grafo.getVertices();
-    std::sort(vertices.begin(), vertices.end());
-    int n = vertices.size();
-    
-    // Cria mapeamento índice -> vértice e vice-versa
-    std::unordered_map<int, int> vertice_para_indice;
-    for (int i = 0; i < n; i++) {
-        vertice_para_indice[vertices[i]] = i;
-    }
-    
-    // Inicializa matriz de distâncias
-    std::vector<std::vector<double>> dist(n, std::vector<double>(n));
-    
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            if (i == j) {
-                dist[i][j] = 0;
-            } else {
-                int u = vertices[i];
-                int v = vertices[j];
-                dist[i][j] = grafo.peso(u, v);
-            }
+// Escreve uma linha "v:d1,d2,..." no buffer, no mesmo formato do ostream padrão:
+// "inf", inteiro quando não há parte fracionária, senão %g com 6 dígitos
+void escreverLinha(std::string& saida, int vertice, const double* dist, int n) {
+    char numero[32];
+    auto [fimV, erroV] = std::to_chars(numero, numero + sizeof numero, vertice);
+    saida.append(numero, fimV);
+    saida += ':';
+    for (int j = 0; j < n; j++) {
+        if (j > 0) saida += ',';
+        double x = dist[j];
+        if (x == std::numeric_limits<double>::infinity()) {
+            saida += "inf";
+            continue;
         }
-    }
-    
-    // Algoritmo de Floyd-Warshall
-    for (int k = 0; k < n; k++) {
-        for (int i = 0; i < n; i++) {
-            for (int j = 0; j < n; j++) {
-                if (dist[i][k] != std::numeric_limits<double>::infinity() &&
-                    dist[k][j] != std::numeric_limits<double>::infinity()) {
-                    double nova_dist = dist[i][k] + dist[k][j];
-                    if (nova_dist < dist[i][j]) {
-                        dist[i][j] = nova_dist;
-                    }
-                }
-            }
+        // Remove decimais desnecessários
+        std::to_chars_result r;
+        if (x == (int)x) {
+            r = std::to_chars(numero, numero + sizeof numero, (int)x);
+        } else {
+            r = std::to_chars(numero, numero + sizeof numero, x, std::chars_format::general, 6);
         }
+        saida.append(numero, r.ptr);
     }
-    
-    return dist;
+    saida += '\n';
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Uso: " << argv[0] << " <arquivo_grafo>" << std::endl;
+    if (argc != 2 && argc != 3) {
+        std::cerr << "Uso: " << argv[0] << " <arquivo_grafo> [<threads>]" << std::endl;
         return 1;
     }
-    
+
     std::string arquivo = argv[1];
+    unsigned threads = 0;
+    if (argc == 3 && !lerThreads(argv[2], threads)) {
+        std::cerr << "Erro: número de threads inválido." << std::endl;
+        return 1;
+    }
+    threads = threadsEfetivas(threads);
     Grafo grafo(arquivo);
-    
-    auto matriz_dist = floydWarshall(grafo);
-    std::vector<int> vertices = grafo.getVertices();
-    std::sort(vertices.begin(), vertices.end());
-    
-    for (size_t i = 0; i < vertices.size(); i++) {
-        std::cout << vertices[i] << ":";
-        
-        for (size_t j = 0; j < vertices.size(); j++) {
-            if (j > 0) std::cout << ",";
-            
-            if (matriz_dist[i][j] == std::numeric_limits<double>::infinity()) {
-                std::cout << "inf";
-            } else {
-                // Remove decimais desnecessários
-                if (matriz_dist[i][j] == (int)matriz_dist[i][j]) {
-                    std::cout << (int)matriz_dist[i][j];
-                } else {
-                    std::cout << matriz_dist[i][j];
-                }
-            }
+    grafo.compactar();
+
+    std::vector<int> vertices = grafo.getTodosVertices();
+    MetodoAPSP metodo = escolherMetodoAPSP(grafo, vertices.size());
+
+    // Johnson precisa de potenciais; com ciclo negativo (no grafo não-dirigido, qualquer
+    // aresta negativa) ele não se aplica e fica o FW
+    std::vector<double> h;
+    int rodadas = 0;
+    if (metodo == MetodoAPSP::JOHNSON && !potenciaisJohnson(grafo, h, rodadas)) {
+        metodo = MetodoAPSP::FLOYD_WARSHALL;
+    }
+
+    // Tipo dos elementos guardados e, opcionalmente, o arquivo .apsp onde a matriz fica
+    TipoDistancia tipo = TipoDistancia::FLOAT64;
+    const char* nomeTipo = std::getenv("GRAFO_APSP_TIPO");
+    if (nomeTipo && !tipoDistanciaPorNome(nomeTipo, tipo)) {
+        std::cerr << "Aviso: GRAFO_APSP_TIPO desconhecido (" << nomeTipo << "), usando float64" << std::endl;
+    }
+    if (!pesosRepresentaveis(grafo, tipo)) {
+        std::cerr << "Aviso: pesos que não cabem em " << nomeTipoDistancia(tipo) << ", usando float64" << std::endl;
+        tipo = TipoDistancia::FLOAT64;
+    }
+    const char* arquivoMatriz = std::getenv("GRAFO_APSP_ARQUIVO");
+    std::string caminhoMatriz = arquivoMatriz ? arquivoMatriz : "";
+
+    // Uma linha por vez num buffer reaproveitado, sem flush por linha
+    std::string saida;
+    auto imprimirLinha = [&](int i, const double* linha) {
+        saida.clear();
+        escreverLinha(saida, vertices[i], linha, vertices.size());
+        std::cout.write(saida.data(), saida.size());
+    };
+
+    auto inicio = std::chrono::steady_clock::now();
+    if (metodo == MetodoAPSP::JOHNSON && caminhoMatriz.empty()) {
+        // Sem arquivo, as linhas vão direto para a saída e a matriz nunca existe inteira
+        johnson(grafo, vertices, h, threads, imprimirLinha);
+    } else {
+        ArmazemDistancias matriz_dist(tipo, vertices, caminhoMatriz);
+        if (!matriz_dist.valido()) return 1;
+        std::vector<double> linha(vertices.size());
+        if (metodo == MetodoAPSP::JOHNSON) {
+            johnson(grafo, vertices, h, threads, [&](int i, const double* calculada) {
+                matriz_dist.escreverLinha(i, calculada);
+            });
+        } else {
+            preencherComGrafo(matriz_dist, grafo);
+            floydWarshallBlocado(matriz_dist, threads);
+        }
+        // O texto sai da matriz guardada, lida linha a linha
+        for (size_t i = 0; i < vertices.size(); i++) {
+            matriz_dist.lerLinha(i, linha.data());
+            imprimirLinha(i, linha.data());
         }
-        std::cout << std::endl;
+        matriz_dist.sincronizar();
     }
-    
+    std::cout.flush();
+    std::chrono::duration<double> duracao = std::chrono::steady_clock::now() - inicio;
+
+    if (estatisticasAtivas()) {
+        std::cerr << "[fw] n=" << vertices.size()
+                  << " arestas=" << grafo.qtdArestas()
+                  << " metodo=" << nomeMetodoAPSP(metodo)
+                  << " threads=" << threads
+                  << " tipo=" << nomeTipoDistancia(tipo);
+        if (!caminhoMatriz.empty()) std::cerr << " arquivo=" << caminhoMatriz;
+        if (metodo == MetodoAPSP::JOHNSON) {
+            std::cerr << " rodadas_bellman_ford=" << rodadas;
+        } else {
+            std::cerr << " kernel=" << nomeKernelFW() << " bloco=" << BLOCO_APSP;
+        }
+        std::cerr << " tempo=" << duracao.count() * 1000.0 << " ms (com a saida)" << std::endl;
+    }
+
     return 0;
 }
@@ -0,0 +1,295 @@
+#ifndef FLOYD_WARSHALL_HPP
+#define FLOYD_WARSHALL_HPP
+
+// Floyd-Warshall em blocos (Venkataraman et al.) sobre o ArmazemDistancias.
+//
+// A matriz já vem cortada em blocos de BLOCO_APSP x BLOCO_APSP. Para cada bloco-diagonal kb:
+//   fase 1: FW comum dentro do bloco (kb, kb);
+//   fase 2: blocos da linha kb e da coluna kb, que dependem só do bloco diagonal;
+//   fase 3: todos os outros blocos (i, j), com (i, kb) e (kb, j) já prontos.
+// As fases 2 e 3 rodam em paralelo, com os blocos repartidos por roubo de trabalho.
+//
+// O laço interno é um min-plus sem desvios: c[j] = min(c[j], a + b[j]). Em ponto
+// flutuante inf + x = inf (mesmo com pesos negativos), e em uint32 a soma satura no
+// sentinela, então não é preciso testar infinito. O kernel é escolhido em tempo de
+// execução: AVX-512, AVX2 ou escalar.
+
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include "grafo.hpp"
+#include "paralelo.hpp"
+#include "armazem_distancias.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define FW_X86 1
+#endif
+
+namespace fw_detalhe {
+
+template <typename T>
+using KernelMinPlus = void (*)(T* __restrict c, T a, const T* __restrict b, int n);
+
+template <typename T>
+inline void minPlusEscalar(T* __restrict c, T a, const T* __restrict b, int n) {
+    for (int j = 0; j < n; j++) {
+        T nova = a + b[j];
+        c[j] = nova < c[j] ? nova : c[j];
+    }
+}
+
+// Em 64 bits a soma de dois uint32 não estoura; nova < c[j] garante que cabe em 32
+template <>
+inline void minPlusEscalar<std::uint32_t>(std::uint32_t* __restrict c, std::uint32_t a,
+                                          const std::uint32_t* __restrict b, int n) {
+    for (int j = 0; j < n; j++) {
+        std::uint64_t nova = static_cast<std::uint64_t>(a) + b[j];
+        c[j] = nova < c[j] ? static_cast<std::uint32_t>(nova) : c[j];
+    }
+}
+
+#ifdef FW_X86
+__attribute__((target("avx2"))) inline void minPlusAVX2(double* __restrict c, double a,
+                                                        const double* __restrict b, int n) {
+    __m256d va = _mm256_set1_pd(a);
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m256d nova = _mm256_add_pd(va, _mm256_loadu_pd(b + j));
+        _mm256_storeu_pd(c + j, _mm256_min_pd(_mm256_loadu_pd(c + j), nova));
+    }
+    minPlusEscalar(c + j, a, b + j, n - j);
+}
+
+__attribute__((target("avx2"))) inline void minPlusAVX2(float* __restrict c, float a,
+                                                        const float* __restrict b, int n) {
+    __m256 va = _mm256_set1_ps(a);
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m256 nova = _mm256_add_ps(va, _mm256_loadu_ps(b + j));
+        _mm256_storeu_ps(c + j, _mm256_min_ps(_mm256_loadu_ps(c + j), nova));
+    }
+    minPlusEscalar(c + j, a, b + j, n - j);
+}
+
+// Soma com saturação: se a + b estourou (resultado < b), vira o sentinela UINT32_MAX
+__attribute__((target("avx2"))) inline void minPlusAVX2(std::uint32_t* __restrict c, std::uint32_t a,
+                                                        const std::uint32_t* __restrict b, int n) {
+    __m256i va = _mm256_set1_epi32(static_cast<int>(a));
+    __m256i uns = _mm256_set1_epi32(-1);
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        __m256i soma = _mm256_add_epi32(va, vb);
+        __m256i semEstouro = _mm256_cmpeq_epi32(_mm256_max_epu32(soma, vb), soma);
+        soma = _mm256_or_si256(soma, _mm256_xor_si256(semEstouro, uns));
+        __m256i atual = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + j));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + j), _mm256_min_epu32(atual, soma));
+    }
+    minPlusEscalar(c + j, a, b + j, n - j);
+}
+
+__attribute__((target("avx512f"))) inline void minPlusAVX512(double* __restrict c, double a,
+                                                             const double* __restrict b, int n) {
+    __m512d va = _mm512_set1_pd(a);
+    int j = 0;
+    for (; j + 8 <= n; j += 8) {
+        __m512d nova = _mm512_add_pd(va, _mm512_loadu_pd(b + j));
+        __m512d atual = _mm512_loadu_pd(c + j);
+        __mmask8 menor = _mm512_cmp_pd_mask(nova, atual, _CMP_LT_OQ);
+        _mm512_storeu_pd(c + j, _mm512_mask_mov_pd(atual, menor, nova));
+    }
+    minPlusEscalar(c + j, a, b + j, n - j);
+}
+
+__attribute__((target("avx512f"))) inline void minPlusAVX512(float* __restrict c, float a,
+                                                             const float* __restrict b, int n) {
+    __m512 va = _mm512_set1_ps(a);
+    int j = 0;
+    for (; j + 16 <= n; j += 16) {
+        __m512 nova = _mm512_add_ps(va, _mm512_loadu_ps(b + j));
+        __m512 atual = _mm512_loadu_ps(c + j);
+        __mmask16 menor = _mm512_cmp_ps_mask(nova, atual, _CMP_LT_OQ);
+        _mm512_storeu_ps(c + j, _mm512_mask_mov_ps(atual, menor, nova));
+    }
+    minPlusEscalar(c + j, a, b + j, n - j);
+}
+
+__attribute__((target("avx512f"))) inline void minPlusAVX512(std::uint32_t* __restrict c, std::uint32_t a,
+                                                             const std::uint32_t* __restrict b, int n) {
+    __m512i va = _mm512_set1_epi32(static_cast<int>(a));
+    __m512i uns = _mm512_set1_epi32(-1);
+    int j = 0;
+    for (; j + 16 <= n; j += 16) {
+        __m512i vb = _mm512_loadu_si512(b + j);
+        __m512i soma = _mm512_add_epi32(va, vb);
+        soma = _mm512_mask_mov_epi32(soma, _mm512_cmplt_epu32_mask(soma, vb), uns);
+        __m512i atual = _mm512_loadu_si512(c + j);
+        __mmask16 menor = _mm512_cmplt_epu32_mask(soma, atual);
+        _mm512_storeu_si512(c + j, _mm512_mask_mov_epi32(atual, menor, soma));
+    }
+    minPlusEscalar(c + j, a, b + j, n - j);
+}
+#endif
+
+} // namespace fw_detalhe
+
+// "avx512", "avx2" ou "escalar". GRAFO_SIMD força um deles (se a CPU suportar).
+inline const char* nomeKernelFW() {
+    static const char* nome = [] {
+        const char* pedido = std::getenv("GRAFO_SIMD");
+        std::string p = pedido ? pedido : "";
+#ifdef FW_X86
+        __builtin_cpu_init();
+        bool avx512 = __builtin_cpu_supports("avx512f");
+        bool avx2 = __builtin_cpu_supports("avx2");
+        if (p == "escalar") return "escalar";
+        if (p == "avx2") return avx2 ? "avx2" : "escalar";
+        if (avx512 && p != "avx2") return "avx512";
+        if (avx2) return "avx2";
+#endif
+        return "escalar";
+    }();
+    return nome;
+}
+
+template <typename T>
+fw_detalhe::KernelMinPlus<T> kernelFW() {
+    std::string nome = nomeKernelFW();
+#ifdef FW_X86
+    if (nome == "avx512") return fw_detalhe::minPlusAVX512;
+    if (nome == "avx2") return fw_detalhe::minPlusAVX2;
+#endif
+    return fw_detalhe::minPlusEscalar<T>;
+}
+
+namespace fw_detalhe {
+
+// C = min(C, A (+) B) com os k de um bloco; blocos de BLOCO_APSP x BLOCO_APSP contíguos.
+// Com k por fora vale também quando C coincide com A e/ou B (fases 1 e 2).
+template <typename T>
+void atualizarBloco(T* c, const T* a, const T* b, KernelMinPlus<T> kernel, bool sobrepoe) {
+    const int B = BLOCO_APSP;
+    if (sobrepoe) {
+        for (int k = 0; k < B; k++) {
+            const T* linhaK = b + k * B;
+            for (int i = 0; i < B; i++) {
+                T* linhaC = c + i * B;
+                if (linhaC == linhaK) continue; // linha k contra ela mesma: d[k][k] >= 0 não melhora nada
+                kernel(linhaC, a[i * B + k], linhaK, B);
+            }
+        }
+    } else {
+        // Blocos disjuntos: i por fora mantém a linha de C quente durante todos os k
+        for (int i = 0; i < B; i++) {
+            T* linhaC = c + i * B;
+            for (int k = 0; k < B; k++) {
+                kernel(linhaC, a[i * B + k], b + k * B, B);
+            }
+        }
+    }
+}
+
+template <typename T>
+void floydWarshallTipado(ArmazemDistancias& d, unsigned numThreads) {
+    int blocos = d.numBlocos();
+    numThreads = std::min<unsigned>(numThreads, std::max(1, blocos * blocos));
+    KernelMinPlus<T> kernel = kernelFW<T>();
+
+    Barreira barreira(numThreads);
+    DivisaoTrabalho trabalho(numThreads);
+
+    // Fase 2: índice b < blocos é o bloco (kb, b), senão o bloco (b - blocos, kb)
+    // Fase 3: índice b é o bloco (b / blocos, b % blocos)
+    auto trabalhar = [&](unsigned id) {
+        std::size_t b;
+        for (int kb = 0; kb < blocos; kb++) {
+            T* diagonal = d.bloco<T>(kb, kb);
+            if (id == 0) {
+                atualizarBloco(diagonal, diagonal, diagonal, kernel, true);
+                trabalho.preparar(2 * blocos);
+            }
+            barreira.esperar();
+            while (trabalho.pegar(id, b)) {
+                int outro = static_cast<int>(b % blocos);
+                if (outro == kb) continue;
+                if (static_cast<int>(b) < blocos) {
+                    T* c = d.bloco<T>(kb, outro);
+                    atualizarBloco(c, diagonal, c, kernel, true);
+                } else {
+                    T* c = d.bloco<T>(outro, kb);
+                    atualizarBloco(c, c, diagonal, kernel, true);
+                }
+            }
+            barreira.esperar();
+            if (id == 0) trabalho.preparar(static_cast<std::size_t>(blocos) * blocos);
+            barreira.esperar();
+            while (trabalho.pegar(id, b)) {
+                int bi = static_cast<int>(b / blocos);
+                int bj = static_cast<int>(b % blocos);
+                if (bi == kb || bj == kb) continue;
+                atualizarBloco(d.bloco<T>(bi, bj), d.bloco<T>(bi, kb), d.bloco<T>(kb, bj), kernel, false);
+            }
+            barreira.esperar();
+        }
+    };
+    emParalelo(numThreads, trabalhar);
+}
+
+template <typename T>
+void preencherTipado(ArmazemDistancias& d, const Grafo& grafo) {
+    const std::vector<int>& vertices = d.vertices();
+    int n = vertices.size();
+    std::vector<int> indice(grafo.idMaximo() + 1, -1);
+    for (int i = 0; i < n; i++) {
+        if (vertices[i] >= 0 && vertices[i] <= grafo.idMaximo()) indice[vertices[i]] = i;
+    }
+    for (int i = 0; i < n; i++) {
+        d.em<T>(i, i) = T(0);
+        auto vizinhos = grafo.vizinhanca(vertices[i]);
+        auto pesos = grafo.pesosVizinhanca(vertices[i]);
+        for (std::size_t k = 0; k < vizinhos.size(); k++) {
+            int j = indice[vizinhos[k]];
+            if (j >= 0 && j != i) d.em<T>(i, j) = ElementoDistancia<T>::deDouble(pesos[k]);
+        }
+    }
+}
+
+} // namespace fw_detalhe
+
+// uint32 só representa pesos inteiros não negativos abaixo do sentinela; os outros tipos, qualquer peso
+inline bool pesosRepresentaveis(const Grafo& grafo, TipoDistancia tipo) {
+    if (tipo != TipoDistancia::UINT32) return true;
+    for (int v = 0; v <= grafo.idMaximo(); v++) {
+        for (double w : grafo.pesosVizinhanca(v)) {
+            if (w < 0 || w != std::floor(w) || w >= ElementoDistancia<std::uint32_t>::INFINITO) return false;
+        }
+    }
+    return true;
+}
+
+// Matriz inicial: 0 na diagonal, o peso nas arestas, infinito no resto (d já vem infinita)
+inline void preencherComGrafo(ArmazemDistancias& d, const Grafo& grafo) {
+    switch (d.tipo()) {
+        case TipoDistancia::FLOAT32: fw_detalhe::preencherTipado<float>(d, grafo); break;
+        case TipoDistancia::UINT32: fw_detalhe::preencherTipado<std::uint32_t>(d, grafo); break;
+        default: fw_detalhe::preencherTipado<double>(d, grafo); break;
+    }
+}
+
+// Fecha d em distâncias mínimas, no lugar. numThreads = 0 usa todos os núcleos.
+inline void floydWarshallBlocado(ArmazemDistancias& d, unsigned numThreads = 0) {
+    numThreads = threadsEfetivas(numThreads);
+    if (d.numBlocos() == 0) return;
+    switch (d.tipo()) {
+        case TipoDistancia::FLOAT32: fw_detalhe::floydWarshallTipado<float>(d, numThreads); break;
+        case TipoDistancia::UINT32: fw_detalhe::floydWarshallTipado<std::uint32_t>(d, numThreads); break;
+        default: fw_detalhe::floydWarshallTipado<double>(d, numThreads); break;
+    }
+}
+
+#endif
@@ -2,14 +2,49 @@
 #define GRAFO_HPP
 
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <string>
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
 #include <limits>
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "leitor_pajek.hpp"
+#include "snapshot_gbin.hpp"
+
+// Visão somente-leitura de um trecho contíguo de um array (não aloca nada)
+template <typename T>
+struct Trecho {
+    const T* inicio;
+    const T* fim;
+
+    const T* begin() const { return inicio; }
+    const T* end() const { return fim; }
+    std::size_t size() const { return fim - inicio; }
+    bool empty() const { return inicio == fim; }
+    const T& operator[](std::size_t i) const { return inicio[i]; }
+};
+
+// Arrays do modo CSR. Imutável e compartilhado entre cópias do Grafo: os ponteiros
+// apontam para os vetores próprios ou direto para um .gbin mapeado em memória.
+struct ArmazemCSR {
+    std::vector<std::uint64_t> offsets_proprios;
+    std::vector<int> destinos_proprios;
+    std::vector<double> pesos_proprios;
+    std::unique_ptr<SnapshotGbin> snapshot;
+    const std::uint64_t* offsets = nullptr;
+    const int* destinos = nullptr;
+    const double* pesos = nullptr;
+
+    void apontarParaProprios() {
+        offsets = offsets_proprios.data();
+        destinos = destinos_proprios.data();
+        pesos = pesos_proprios.data();
+    }
+};
+
+static_assert(sizeof(int) == sizeof(std::int32_t), "destinos do .gbin são int32");
 
 class Grafo {
 private:
@@ -18,10 +53,31 @@ private:
     int num_vertices;
     int num_arestas;
 
+    // Modo CSR (compressed sparse row), imutável após compactar() ou lerSnapshot():
+    // os vizinhos de v ficam em destinos[offsets[v] .. offsets[v+1]), já ordenados,
+    // com o peso correspondente na mesma posição de pesos.
+    bool modo_csr;
+    int id_maximo; // vértices densos 0..id_maximo (o índice 0 fica vazio no .net)
+    std::shared_ptr<const ArmazemCSR> csr;
+
+    bool idValido(int v) const {
+        return v >= 0 && v <= id_maximo;
+    }
+
+    // Posição de (u, v) no array de destinos, ou SIZE_MAX se a aresta não existir
+    std::size_t posicaoCSR(int u, int v) const {
+        auto viz = vizinhanca(u);
+        const int* it = std::lower_bound(viz.begin(), viz.end(), v);
+        if (it != viz.end() && *it == v) {
+            return it - csr->destinos;
+        }
+        return std::numeric_limits<std::size_t>::max();
+    }
+
 public:
-    Grafo() : num_vertices(0), num_arestas(0) {}
+    Grafo() : num_vertices(0), num_arestas(0), modo_csr(false), id_maximo(-1) {}
     
-    Grafo(const std::string& arquivo) : num_vertices(0), num_arestas(0) {
+    Grafo(const std::string& arquivo) : num_vertices(0), num_arestas(0), modo_csr(false), id_maximo(-1) {
         ler(arquivo);
     }
     
@@ -34,6 +90,9 @@ public:
     }
     
     int grau(int v) const {
+        if (modo_csr) {
+            return idValido(v) ? static_cast<int>(csr->offsets[v + 1] - csr->offsets[v]) : 0;
+        }
         auto it = adjacencias.find(v);
         if (it != adjacencias.end()) {
             return it->second.size();
@@ -42,6 +101,9 @@ public:
     }
     
     std::string rotulo(int v) const {
+        if (modo_csr && csr->snapshot) {
+            return csr->snapshot->rotulo(v);
+        }
         auto it = vertices.find(v);
         if (it != vertices.end()) {
             return it->second;
@@ -50,6 +112,10 @@ public:
     }
     
     std::vector<int> vizinhos(int v) const {
+        if (modo_csr) {
+            auto trecho = vizinhanca(v);
+            return std::vector<int>(trecho.begin(), trecho.end());
+        }
         std::vector<int> viz;
         auto it = adjacencias.find(v);
         if (it != adjacencias.end()) {
@@ -62,6 +128,9 @@ public:
     }
     
     bool haAresta(int u, int v) const {
+        if (modo_csr) {
+            return posicaoCSR(u, v) != std::numeric_limits<std::size_t>::max();
+        }
         auto it = adjacencias.find(u);
         if (it != adjacencias.end()) {
             return it->second.find(v) != it->second.end();
@@ -70,6 +139,13 @@ public:
     }
     
     double peso(int u, int v) const {
+        if (modo_csr) {
+            std::size_t pos = posicaoCSR(u, v);
+            if (pos != std::numeric_limits<std::size_t>::max()) {
+                return csr->pesos[pos];
+            }
+            return std::numeric_limits<double>::infinity();
+        }
         if (haAresta(u, v)) {
             return adjacencias.at(u).at(v);
         }
@@ -77,75 +153,208 @@ public:
     }
     
     void ler(const std::string& arquivo) {
-        std::ifstream file(arquivo);
-        if (!file.is_open()) {
-            std::cerr << "Erro ao abrir arquivo: " << arquivo << std::endl;
+        if (ehArquivoGbin(arquivo)) {
+            lerSnapshot(arquivo);
             return;
         }
         
-        std::string linha;
+        ConteudoPajek conteudo = lerPajek(arquivo);
+        if (!conteudo.aberto) {
+            std::cerr << "Erro ao abrir arquivo: " << arquivo << std::endl;
+            return;
+        }
         
-        // Lê primeira linha (*vertices n)
-        std::getline(file, linha);
-        std::istringstream iss(linha);
-        std::string vertices_str;
-        iss >> vertices_str >> num_vertices;
+        num_vertices = conteudo.numVertices;
         
-        // Lê rótulos dos vértices
-        for (int i = 0; i < num_vertices; i++) {
-            std::getline(file, linha);
-            std::istringstream iss_vertex(linha);
-            int indice;
-            std::string rotulo_vertex;
-            iss_vertex >> indice;
-            
-            // Pega o resto da linha como rótulo
-            if (iss_vertex >> rotulo_vertex) {
-                vertices[indice] = rotulo_vertex;
-            } else {
-                vertices[indice] = std::to_string(indice);
+        // Ids negativos não cabem no CSR de compactar() (vértices 0..id_maximo): as linhas
+        // com eles são ignoradas, com aviso
+        std::size_t negativas = 0;
+
+        // Rótulo é a primeira palavra após o índice
+        for (std::size_t i = 0; i < conteudo.indices.size(); i++) {
+            if (conteudo.indices[i] < 0) {
+                negativas++;
+                continue;
             }
+            const std::string& linha = conteudo.rotulos[i];
+            std::string rotulo_vertex = linha.substr(0, linha.find_first_of(" \t"));
+            vertices[conteudo.indices[i]] = rotulo_vertex.empty() ? std::to_string(conteudo.indices[i])
+                                                                  : rotulo_vertex;
         }
         
-        // Procura por *edges
-        while (std::getline(file, linha)) {
-            if (linha.find("*edges") != std::string::npos) {
-                break;
+        // Lê arestas (só linhas "u v peso" completas)
+        for (std::size_t i = 0; i < conteudo.numArestas(); i++) {
+            if (!conteudo.temPeso[i]) continue;
+            int u = conteudo.origens[i];
+            int v = conteudo.destinos[i];
+            double peso_aresta = conteudo.pesos[i];
+            if (u < 0 || v < 0) {
+                negativas++;
+                continue;
+            }
+            
+            // Grafo não-dirigido: adiciona em ambas as direções.
+            // A aresta é nova exatamente quando u -> v ainda não existia.
+            if (adjacencias[u].insert_or_assign(v, peso_aresta).second) {
+                num_arestas++;
             }
+            adjacencias[v][u] = peso_aresta;
         }
-        
-        // Lê arestas
-        std::unordered_set<std::string> arestas_unicas;
-        while (std::getline(file, linha)) {
-            if (!linha.empty()) {
-                std::istringstream iss_edge(linha);
-                int u, v;
-                double peso_aresta;
-                if (iss_edge >> u >> v >> peso_aresta) {
-                    // Grafo não-dirigido: adiciona em ambas as direções
-                    adjacencias[u][v] = peso_aresta;
-                    adjacencias[v][u] = peso_aresta;
-                    
-                    // Conta aresta única
-                    std::string aresta_id = (u < v) ? std::to_string(u) + "-" + std::to_string(v) 
-                                                    : std::to_string(v) + "-" + std::to_string(u);
-                    arestas_unicas.insert(aresta_id);
-                }
+        if (negativas > 0) {
+            std::cerr << "Aviso: " << negativas << " linhas com vértice negativo ignoradas em " << arquivo << std::endl;
+        }
+        // Os grafos da parte I são não dirigidos: arcos entram como arestas, com aviso
+        for (const auto& secao : conteudo.secoes) {
+            if (secao.dirigida && secao.fim > secao.inicio) {
+                std::cerr << "Aviso: seção *arcs de " << arquivo << " lida como arestas não dirigidas" << std::endl;
+                break;
             }
         }
-        
-        num_arestas = arestas_unicas.size();
-        file.close();
     }
     
     std::vector<int> getTodosVertices() const {
         std::vector<int> todos;
+        if (modo_csr && csr->snapshot) {
+            for (int v = 1; v <= num_vertices; v++) {
+                todos.push_back(v);
+            }
+            return todos;
+        }
         for (const auto& par : vertices) {
             todos.push_back(par.first);
         }
         std::sort(todos.begin(), todos.end());
         return todos;
     }
+
+    // Converte as adjacências para o modo CSR e libera as tabelas hash.
+    // Depois disso o grafo é imutável; vizinhanca()/pesosVizinhanca() passam a valer.
+    void compactar() {
+        if (modo_csr) return;
+
+        id_maximo = num_vertices;
+        for (const auto& par : adjacencias) {
+            id_maximo = std::max(id_maximo, par.first);
+        }
+
+        auto armazem = std::make_shared<ArmazemCSR>();
+        auto& offsets = armazem->offsets_proprios;
+        offsets.assign(id_maximo + 2, 0);
+        for (const auto& par : adjacencias) {
+            offsets[par.first + 1] = par.second.size();
+        }
+        for (int v = 0; v <= id_maximo; v++) {
+            offsets[v + 1] += offsets[v];
+        }
+
+        armazem->destinos_proprios.resize(offsets[id_maximo + 1]);
+        armazem->pesos_proprios.resize(offsets[id_maximo + 1]);
+        std::vector<std::pair<int, double>> linha;
+        for (const auto& par : adjacencias) {
+            linha.assign(par.second.begin(), par.second.end());
+            std::sort(linha.begin(), linha.end());
+            std::uint64_t pos = offsets[par.first];
+            for (const auto& aresta : linha) {
+                armazem->destinos_proprios[pos] = aresta.first;
+                armazem->pesos_proprios[pos] = aresta.second;
+                pos++;
+            }
+        }
+        armazem->apontarParaProprios();
+        csr = armazem;
+
+        std::unordered_map<int, std::unordered_map<int, double>>().swap(adjacencias);
+        modo_csr = true;
+    }
+
+    // Abre um .gbin. Se as linhas já vierem ordenadas (gravado por este Grafo), o CSR
+    // aponta direto para o arquivo mapeado e a carga é O(1); senão, as linhas são
+    // copiadas, ordenadas e sem repetição (vale o último peso, como em ler()).
+    void lerSnapshot(const std::string& arquivo) {
+        auto snapshot = std::make_unique<SnapshotGbin>(arquivo);
+        // A parte I só trata grafos não dirigidos: um snapshot de grafo dirigido guarda
+        // cada arco uma vez só e não serve como lista de adjacência simétrica
+        if (!snapshot->valido() || snapshot->dirigido()) {
+            std::cerr << "Erro: snapshot inválido: " << arquivo << std::endl;
+            return;
+        }
+
+        auto armazem = std::make_shared<ArmazemCSR>();
+        num_vertices = snapshot->numVertices();
+        num_arestas = static_cast<int>(snapshot->numArestas());
+        id_maximo = num_vertices;
+
+        if (snapshot->linhasOrdenadas()) {
+            armazem->offsets = snapshot->offsets();
+            armazem->destinos = snapshot->destinos();
+            armazem->pesos = snapshot->pesos();
+        } else {
+            const std::uint64_t* offsets = snapshot->offsets();
+            armazem->offsets_proprios.assign(id_maximo + 2, 0);
+            std::vector<std::pair<int, double>> linha;
+            for (int v = 0; v <= id_maximo; v++) {
+                linha.clear();
+                for (std::uint64_t i = offsets[v]; i < offsets[v + 1]; i++) {
+                    linha.push_back({snapshot->destinos()[i], snapshot->pesos()[i]});
+                }
+                std::stable_sort(linha.begin(), linha.end(), [](const auto& a, const auto& b) {
+                    return a.first < b.first;
+                });
+                for (std::size_t i = 0; i < linha.size(); i++) {
+                    if (i + 1 < linha.size() && linha[i + 1].first == linha[i].first) continue;
+                    armazem->destinos_proprios.push_back(linha[i].first);
+                    armazem->pesos_proprios.push_back(linha[i].second);
+                }
+                armazem->offsets_proprios[v + 1] = armazem->destinos_proprios.size();
+            }
+            armazem->apontarParaProprios();
+        }
+
+        armazem->snapshot = std::move(snapshot);
+        csr = armazem;
+        modo_csr = true;
+    }
+
+    // Grava o grafo (já em CSR) como .gbin, com linhas ordenadas
+    bool salvarSnapshot(const std::string& arquivo) {
+        compactar();
+        std::vector<std::string> rotulos(id_maximo + 1);
+        for (int v = 1; v <= id_maximo; v++) {
+            rotulos[v] = rotulo(v);
+        }
+        return gravarGbin(arquivo, GBIN_PONDERADO | GBIN_LINHAS_ORDENADAS, id_maximo, num_arestas,
+                          csr->offsets, csr->destinos, csr->pesos, rotulos);
+    }
+
+    bool compacto() const {
+        return modo_csr;
+    }
+
+    // Maior índice de vértice representável no CSR (arrays densos usam id_maximo + 1)
+    int idMaximo() const {
+        return modo_csr ? id_maximo : num_vertices;
+    }
+
+    // Vizinhos de v em ordem crescente, sem alocação. Requer compactar().
+    Trecho<int> vizinhanca(int v) const {
+        if (!modo_csr || !idValido(v)) {
+            return {nullptr, nullptr};
+        }
+        return {csr->destinos + csr->offsets[v], csr->destinos + csr->offsets[v + 1]};
+    }
+
+    // Pesos alinhados com vizinhanca(v): pesosVizinhanca(v)[i] é o peso de v -> vizinhanca(v)[i]
+    Trecho<double> pesosVizinhanca(int v) const {
+        if (!modo_csr || !idValido(v)) {
+            return {nullptr, nullptr};
+        }
+        return {csr->pesos + csr->offsets[v], csr->pesos + csr->offsets[v + 1]};
+    }
+
+    // Posição global do início da vizinhança de v (útil para ids de aresta)
+    std::size_t inicioVizinhanca(int v) const {
+        return idValido(v) ? csr->offsets[v] : 0;
+    }
 };
 
 #endif
@@ -0,0 +1,535 @@
+#ifndef HIERARQUIA_CONTRACAO_HPP
+#define HIERARQUIA_CONTRACAO_HPP
+
+// Contraction Hierarchies (Geisberger et al.) sobre o CSR do Grafo.
+//
+// Pré-processamento: os vértices são contraídos um a um, do menos ao mais
+// "importante". Contrair v liga cada par de vizinhos (u, w) ainda não contraídos
+// por um atalho de peso w(u,v) + w(v,w), a menos que uma busca de testemunha
+// (Dijkstra local que evita v) ache um caminho u -> w tão curto quanto.
+// A ordem vem de uma fila preguiçosa pela prioridade
+//     diferença de arestas (atalhos criados - arestas removidas) + vizinhos já contraídos.
+//
+// Consulta: Dijkstra bidirecional que só sobe na hierarquia (arestas para vértices
+// de nível maior), a partir de s e de t. Como o grafo é não dirigido, um único grafo
+// "para cima" serve às duas buscas. Atalhos guardam o vértice do meio para o caminho
+// ser desempacotado em arestas originais. Com stall-on-demand, vértices alcançados
+// por uma distância que um vizinho mais alto já supera não são expandidos.
+//
+// Em grafos sem hierarquia natural (aleatórios, densos) os graus explodem com os
+// atalhos. Por isso a contração para quando o próximo vértice passa de
+// LIMITE_GRAU_NUCLEO vizinhos: os vértices restantes formam um "núcleo" que guarda
+// todas as suas arestas entre si, e a consulta vira um Dijkstra bidirecional comum
+// ao chegar nele. As duas buscas continuam até a própria fila passar do melhor
+// caminho, então o resultado segue exato.
+
+#include <vector>
+#include <string>
+#include <queue>
+#include <limits>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include "grafo.hpp"
+#include "filas_prioridade.hpp"
+#include "ponto_a_ponto.hpp"
+
+// Vértices com mais vizinhos que isso não são contraídos e vão para o núcleo
+const std::size_t LIMITE_GRAU_NUCLEO = 64;
+
+// Grafo "para cima" em CSR: de cada v saem só arestas para vértices de nível maior
+struct HierarquiaContracao {
+    int tamanho = 0;                  // idMaximo + 1 do grafo
+    std::uint64_t entradasCSR = 0;    // para reconhecer um arquivo de outro grafo
+    std::uint64_t assinatura = 0;     // ... ou do mesmo grafo com outros pesos
+    std::vector<int> nivel;           // posição de cada vértice na ordem de contração
+    std::vector<std::uint64_t> offsets;
+    std::vector<int> destinos;
+    std::vector<double> pesos;
+    std::vector<int> meios;           // vértice contraído do atalho, ou -1 se aresta original
+    std::uint64_t atalhos = 0;
+    int nucleo = 0;                   // vértices deixados sem contrair
+    double segundos = 0.0;            // tempo do pré-processamento
+};
+
+namespace ch_detalhe {
+
+struct ArestaCH {
+    int destino;
+    double peso;
+    int meio;
+};
+
+// Estado do pré-processamento. adj[v] só guarda vizinhos ainda não contraídos:
+// ao contrair v, suas arestas passam para acima[v] (todas levam a níveis maiores)
+// e v sai das listas dos vizinhos, o que mantém as buscas de testemunha curtas.
+class ConstrutorCH {
+private:
+    int tamanho;
+    std::vector<std::vector<ArestaCH>> adj;
+    std::vector<std::vector<ArestaCH>> acima;
+    std::vector<char> contraido;
+    std::vector<int> vizinhosContraidos;
+
+    // Busca de testemunha com distâncias "carimbadas" para não limpar arrays a cada busca
+    std::vector<double> distTestemunha;
+    std::vector<unsigned> carimbo;
+    std::vector<unsigned> alvo;
+    std::vector<int> saltos;
+    unsigned rodada = 0;
+    std::vector<std::pair<double, int>> heapTestemunha; // reaproveitado entre buscas
+
+    struct Atalho {
+        int u, w;
+        double peso;
+    };
+
+    double distancia(int v) const {
+        return carimbo[v] == rodada ? distTestemunha[v] : std::numeric_limits<double>::infinity();
+    }
+
+    // Dijkstra a partir de u, ignorando `evitar`, até assentar os `alvos` marcados,
+    // passar de `limite` ou examinar `maxArestas` arestas; caminhos com mais de `maxSaltos`
+    // arestas não são estendidos. Parar cedo só gera atalhos a mais, nunca a menos.
+    void buscaTestemunha(int u, int evitar, int alvos, double limite, int maxArestas, int maxSaltos) {
+        using Par = std::pair<double, int>;
+        auto& fila = heapTestemunha;
+        auto maior = std::greater<Par>();
+        fila.clear();
+        distTestemunha[u] = 0;
+        saltos[u] = 0;
+        carimbo[u] = rodada;
+        fila.push_back({0, u});
+        int examinadas = 0;
+        while (!fila.empty() && alvos > 0) {
+            std::pop_heap(fila.begin(), fila.end(), maior);
+            auto [d, x] = fila.back();
+            fila.pop_back();
+            if (d > distancia(x)) continue;
+            if (d > limite || examinadas > maxArestas) break;
+            if (alvo[x] == rodada) alvos--;
+            if (saltos[x] >= maxSaltos) continue;
+            examinadas += static_cast<int>(adj[x].size());
+            for (const auto& a : adj[x]) {
+                if (a.destino == evitar) continue;
+                double nova = d + a.peso;
+                if (nova < distancia(a.destino)) {
+                    distTestemunha[a.destino] = nova;
+                    saltos[a.destino] = saltos[x] + 1;
+                    carimbo[a.destino] = rodada;
+                    fila.push_back({nova, a.destino});
+                    std::push_heap(fila.begin(), fila.end(), maior);
+                }
+            }
+        }
+    }
+
+    // Atalhos necessários para contrair v (sem aplicá-los)
+    std::vector<Atalho> atalhosDe(int v, int maxArestas, int maxSaltos) {
+        std::vector<Atalho> atalhos;
+        const auto& viz = adj[v];
+        // Cada par (u, w) é tratado uma vez, pelo u de menor índice na lista
+        for (std::size_t i = 0; i + 1 < viz.size(); i++) {
+            rodada++;
+            double limite = 0;
+            for (std::size_t j = i + 1; j < viz.size(); j++) {
+                alvo[viz[j].destino] = rodada;
+                limite = std::max(limite, viz[i].peso + viz[j].peso);
+            }
+            buscaTestemunha(viz[i].destino, v, static_cast<int>(viz.size() - i - 1), limite, maxArestas, maxSaltos);
+            for (std::size_t j = i + 1; j < viz.size(); j++) {
+                double viaV = viz[i].peso + viz[j].peso;
+                if (distancia(viz[j].destino) > viaV) {
+                    atalhos.push_back({viz[i].destino, viz[j].destino, viaV});
+                }
+            }
+        }
+        return atalhos;
+    }
+
+    // Insere (ou melhora) a aresta u - w
+    void ligar(int u, int w, double peso, int meio) {
+        for (auto& a : adj[u]) {
+            if (a.destino == w) {
+                if (peso < a.peso) {
+                    a.peso = peso;
+                    a.meio = meio;
+                }
+                return;
+            }
+        }
+        adj[u].push_back({w, peso, meio});
+    }
+
+    void desligar(int u, int w) {
+        auto& lista = adj[u];
+        for (std::size_t i = 0; i < lista.size(); i++) {
+            if (lista[i].destino == w) {
+                lista[i] = lista.back();
+                lista.pop_back();
+                return;
+            }
+        }
+    }
+
+public:
+    std::vector<int> nivel;
+    std::uint64_t atalhosCriados = 0;
+
+    explicit ConstrutorCH(const Grafo& grafo)
+        : tamanho(grafo.idMaximo() + 1), adj(tamanho), acima(tamanho), contraido(tamanho, 0),
+          vizinhosContraidos(tamanho, 0), distTestemunha(tamanho, 0), carimbo(tamanho, 0),
+          alvo(tamanho, 0), saltos(tamanho, 0), nivel(tamanho, 0) {
+        for (int v = 0; v < tamanho; v++) {
+            auto vizinhos = grafo.vizinhanca(v);
+            auto pesos = grafo.pesosVizinhanca(v);
+            for (std::size_t i = 0; i < vizinhos.size(); i++) {
+                if (vizinhos[i] != v) adj[v].push_back({vizinhos[i], pesos[i], -1});
+            }
+        }
+    }
+
+    int prioridade(int v) {
+        // Vértice que já é do núcleo: nem simula (seriam grau² buscas)
+        if (adj[v].size() > LIMITE_GRAU_NUCLEO) {
+            return std::numeric_limits<int>::max() / 2 + static_cast<int>(adj[v].size());
+        }
+        // Busca de testemunha mais curta na simulação: só orienta a ordem
+        int atalhos = static_cast<int>(atalhosDe(v, 1000, 3).size());
+        return atalhos - static_cast<int>(adj[v].size()) + vizinhosContraidos[v];
+    }
+
+    void contrair(int v, int ordem) {
+        for (const auto& a : atalhosDe(v, 10000, 6)) {
+            ligar(a.u, a.w, a.peso, v);
+            ligar(a.w, a.u, a.peso, v);
+            atalhosCriados++;
+        }
+        contraido[v] = 1;
+        nivel[v] = ordem;
+        for (const auto& a : adj[v]) {
+            desligar(a.destino, v);
+            vizinhosContraidos[a.destino]++;
+        }
+        acima[v].swap(adj[v]);
+    }
+
+    // Núcleo: v fica acima de todos os contraídos e mantém todas as arestas do núcleo
+    void fecharNucleo(int v, int ordem) {
+        contraido[v] = 1;
+        nivel[v] = ordem;
+        acima[v] = adj[v];
+    }
+
+    std::size_t grau(int v) const { return adj[v].size(); }
+    bool ehContraido(int v) const { return contraido[v]; }
+    // Antes de contrair v: vizinhos não contraídos; depois: arestas para níveis maiores
+    const std::vector<ArestaCH>& vizinhos(int v) const { return contraido[v] ? acima[v] : adj[v]; }
+    int numVertices() const { return tamanho; }
+};
+
+} // namespace ch_detalhe
+
+inline HierarquiaContracao construirHierarquia(const Grafo& grafo) {
+    auto inicio = std::chrono::steady_clock::now();
+    ch_detalhe::ConstrutorCH construtor(grafo);
+    int tamanho = construtor.numVertices();
+
+    // A prioridade de v só muda quando um vizinho é contraído. Em vez de recalcular
+    // todos os vizinhos a cada contração (grau² buscas), eles são marcados como sujos e
+    // recalculados só ao chegar ao topo; se a prioridade piorou, v volta para a fila.
+    using Par = std::pair<int, int>;
+    std::priority_queue<Par, std::vector<Par>, std::greater<Par>> fila;
+    std::vector<int> prioridade(tamanho);
+    std::vector<char> sujo(tamanho, 0);
+    for (int v = 0; v < tamanho; v++) {
+        prioridade[v] = construtor.prioridade(v);
+        fila.push({prioridade[v], v});
+    }
+
+    int ordem = 0;
+    while (!fila.empty()) {
+        auto [p, v] = fila.top();
+        fila.pop();
+        if (construtor.ehContraido(v) || p != prioridade[v]) continue;
+        if (sujo[v]) {
+            sujo[v] = 0;
+            prioridade[v] = construtor.prioridade(v);
+            if (prioridade[v] != p) {
+                fila.push({prioridade[v], v});
+                continue;
+            }
+        }
+        if (construtor.grau(v) > LIMITE_GRAU_NUCLEO) {
+            break; // o menor da fila já é do núcleo, então todos os restantes também são
+        }
+        construtor.contrair(v, ordem++);
+        for (const auto& a : construtor.vizinhos(v)) {
+            sujo[a.destino] = 1;
+        }
+    }
+
+    HierarquiaContracao h;
+    for (int v = 0; v < tamanho; v++) {
+        if (!construtor.ehContraido(v)) {
+            construtor.fecharNucleo(v, ordem++);
+            h.nucleo++;
+        }
+    }
+
+    // Monta o grafo "para cima" a partir das arestas guardadas em cada contração
+
+    h.tamanho = tamanho;
+    h.entradasCSR = entradasCSR(grafo);
+    h.assinatura = assinaturaCSR(grafo);
+    h.nivel = construtor.nivel;
+    h.atalhos = construtor.atalhosCriados;
+    h.offsets.assign(tamanho + 1, 0);
+    for (int v = 0; v < tamanho; v++) {
+        h.offsets[v + 1] = h.offsets[v] + construtor.vizinhos(v).size();
+    }
+    h.destinos.reserve(h.offsets[tamanho]);
+    h.pesos.reserve(h.offsets[tamanho]);
+    h.meios.reserve(h.offsets[tamanho]);
+    for (int v = 0; v < tamanho; v++) {
+        for (const auto& a : construtor.vizinhos(v)) {
+            h.destinos.push_back(a.destino);
+            h.pesos.push_back(a.peso);
+            h.meios.push_back(a.meio);
+        }
+    }
+
+    h.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return h;
+}
+
+// Arquivo <grafo>.ch: "CH02", tamanho, entradasCSR, assinatura, numArestas, atalhos, nucleo,
+// nivel[tamanho], offsets[tamanho + 1], destinos[], pesos[], meios[]
+inline bool salvarHierarquia(const std::string& caminho, const HierarquiaContracao& h) {
+    std::ofstream saida(caminho, std::ios::binary | std::ios::trunc);
+    if (!saida.is_open()) return false;
+    std::uint64_t cab[6] = {static_cast<std::uint64_t>(h.tamanho), h.entradasCSR, h.assinatura, h.destinos.size(),
+                            h.atalhos, static_cast<std::uint64_t>(h.nucleo)};
+    saida.write("CH02", 4);
+    saida.write(reinterpret_cast<const char*>(cab), sizeof(cab));
+    saida.write(reinterpret_cast<const char*>(h.nivel.data()), h.nivel.size() * sizeof(int));
+    saida.write(reinterpret_cast<const char*>(h.offsets.data()), h.offsets.size() * sizeof(std::uint64_t));
+    saida.write(reinterpret_cast<const char*>(h.destinos.data()), h.destinos.size() * sizeof(int));
+    saida.write(reinterpret_cast<const char*>(h.pesos.data()), h.pesos.size() * sizeof(double));
+    saida.write(reinterpret_cast<const char*>(h.meios.data()), h.meios.size() * sizeof(int));
+    return static_cast<bool>(saida);
+}
+
+inline bool carregarHierarquia(const std::string& caminho, const Grafo& grafo, HierarquiaContracao& h) {
+    std::ifstream entrada(caminho, std::ios::binary);
+    if (!entrada.is_open()) return false;
+    char magica[4];
+    std::uint64_t cab[6];
+    entrada.read(magica, 4);
+    entrada.read(reinterpret_cast<char*>(cab), sizeof(cab));
+    if (!entrada || std::memcmp(magica, "CH02", 4) != 0) return false;
+    if (cab[0] != static_cast<std::uint64_t>(grafo.idMaximo() + 1) || cab[1] != entradasCSR(grafo) ||
+        cab[2] != assinaturaCSR(grafo)) {
+        return false; // hierarquia de outra versão do grafo (arestas ou pesos)
+    }
+    // numArestas limitado pelo que cabe no arquivo antes de alocar (cada aresta: destino,
+    // peso e meio)
+    std::uint64_t fixo = 4 + sizeof(cab) + cab[0] * sizeof(int) + (cab[0] + 1) * sizeof(std::uint64_t);
+    entrada.seekg(0, std::ios::end);
+    std::uint64_t tamanhoArquivo = static_cast<std::uint64_t>(entrada.tellg());
+    entrada.seekg(4 + sizeof(cab));
+    if (!entrada || tamanhoArquivo < fixo ||
+        cab[3] > (tamanhoArquivo - fixo) / (sizeof(int) + sizeof(double) + sizeof(int))) {
+        return false;
+    }
+    h.tamanho = static_cast<int>(cab[0]);
+    h.entradasCSR = cab[1];
+    h.assinatura = cab[2];
+    h.atalhos = cab[4];
+    h.nucleo = static_cast<int>(cab[5]);
+    h.nivel.resize(h.tamanho);
+    h.offsets.resize(h.tamanho + 1);
+    h.destinos.resize(cab[3]);
+    h.pesos.resize(cab[3]);
+    h.meios.resize(cab[3]);
+    entrada.read(reinterpret_cast<char*>(h.nivel.data()), h.nivel.size() * sizeof(int));
+    entrada.read(reinterpret_cast<char*>(h.offsets.data()), h.offsets.size() * sizeof(std::uint64_t));
+    entrada.read(reinterpret_cast<char*>(h.destinos.data()), h.destinos.size() * sizeof(int));
+    entrada.read(reinterpret_cast<char*>(h.pesos.data()), h.pesos.size() * sizeof(double));
+    entrada.read(reinterpret_cast<char*>(h.meios.data()), h.meios.size() * sizeof(int));
+    if (!entrada || h.offsets[h.tamanho] != cab[3]) return false;
+
+    // Arquivo corrompido não pode levar a índices fora dos arrays nas consultas: recusado,
+    // e a hierarquia é reconstruída
+    for (int v = 0; v < h.tamanho; v++) {
+        if (h.offsets[v] > h.offsets[v + 1]) return false;
+    }
+    for (std::uint64_t e = 0; e < cab[3]; e++) {
+        if (h.destinos[e] < 0 || h.destinos[e] >= h.tamanho) return false;
+        if (h.meios[e] < -1 || h.meios[e] >= h.tamanho) return false;
+    }
+    return true;
+}
+
+// Carrega <arquivoGrafo>.ch ou, se não existir/estiver desatualizado, constrói e grava
+inline HierarquiaContracao hierarquiaDoGrafo(const Grafo& grafo, const std::string& arquivoGrafo) {
+    HierarquiaContracao h;
+    std::string caminho = arquivoGrafo + ".ch";
+    if (carregarHierarquia(caminho, grafo, h)) return h;
+    h = construirHierarquia(grafo);
+    if (!salvarHierarquia(caminho, h)) {
+        std::cerr << "Aviso: não foi possível gravar " << caminho << std::endl;
+    }
+    return h;
+}
+
+// Motor de consultas: reaproveita filas e arrays entre consultas (só os
+// vértices tocados são reinicializados), para responder milhões delas.
+class ConsultaCH {
+private:
+    const HierarquiaContracao& h;
+    std::vector<double> dist[2];
+    std::vector<std::uint64_t> arestaAnterior[2]; // aresta do CSR usada para chegar ao vértice
+    std::vector<int> tocados[2];
+    HeapQuaternario fila[2];
+
+    static const std::uint64_t SEM_ARESTA = std::numeric_limits<std::uint64_t>::max();
+
+    void reiniciar() {
+        for (int lado = 0; lado < 2; lado++) {
+            for (int v : tocados[lado]) {
+                dist[lado][v] = std::numeric_limits<double>::infinity();
+                arestaAnterior[lado][v] = SEM_ARESTA;
+            }
+            tocados[lado].clear();
+            fila[lado].limpar();
+        }
+    }
+
+    bool parado(int lado, int u) const {
+        for (std::uint64_t e = h.offsets[u]; e < h.offsets[u + 1]; e++) {
+            if (dist[lado][h.destinos[e]] + h.pesos[e] < dist[lado][u]) return true;
+        }
+        return false;
+    }
+
+    // Origem da aresta `e` do CSR (o vértice cuja linha contém e)
+    int origemDe(std::uint64_t e) const {
+        auto it = std::upper_bound(h.offsets.begin(), h.offsets.end(), e);
+        return static_cast<int>(it - h.offsets.begin()) - 1;
+    }
+
+    std::uint64_t acharAresta(int a, int b) const {
+        if (h.nivel[a] > h.nivel[b]) std::swap(a, b);
+        for (std::uint64_t e = h.offsets[a]; e < h.offsets[a + 1]; e++) {
+            if (h.destinos[e] == b) return e;
+        }
+        return SEM_ARESTA;
+    }
+
+    // Acrescenta ao caminho os vértices de `de` até `para` (sem `de`), trocando atalhos pelas arestas originais
+    void desempacotar(int de, int para, std::uint64_t e, std::vector<int>& caminho) const {
+        std::vector<std::pair<int, int>> pilha = {{de, para}};
+        std::vector<std::uint64_t> arestas = {e};
+        while (!pilha.empty()) {
+            auto [a, b] = pilha.back();
+            std::uint64_t aresta = arestas.back();
+            pilha.pop_back();
+            arestas.pop_back();
+            int meio = h.meios[aresta];
+            if (meio < 0) {
+                caminho.push_back(b);
+                continue;
+            }
+            // Empilha a segunda metade primeiro para processar a primeira antes
+            pilha.push_back({meio, b});
+            arestas.push_back(acharAresta(meio, b));
+            pilha.push_back({a, meio});
+            arestas.push_back(acharAresta(a, meio));
+        }
+    }
+
+public:
+    explicit ConsultaCH(const HierarquiaContracao& hierarquia)
+        : h(hierarquia),
+          dist{std::vector<double>(h.tamanho, std::numeric_limits<double>::infinity()),
+               std::vector<double>(h.tamanho, std::numeric_limits<double>::infinity())},
+          arestaAnterior{std::vector<std::uint64_t>(h.tamanho, SEM_ARESTA),
+                         std::vector<std::uint64_t>(h.tamanho, SEM_ARESTA)},
+          fila{HeapQuaternario(h.tamanho), HeapQuaternario(h.tamanho)} {}
+
+    ResultadoPontoAPonto consultar(int s, int t) {
+        auto inicio = std::chrono::steady_clock::now();
+        const double INF = std::numeric_limits<double>::infinity();
+        ResultadoPontoAPonto r;
+        if (s < 0 || s >= h.tamanho || t < 0 || t >= h.tamanho) return r;
+
+        int origem[2] = {s, t};
+        for (int lado = 0; lado < 2; lado++) {
+            dist[lado][origem[lado]] = 0;
+            tocados[lado].push_back(origem[lado]);
+            fila[lado].inserirOuReduzir(origem[lado], 0);
+        }
+
+        double melhor = INF;
+        int encontro = -1;
+        while (true) {
+            bool ativo[2];
+            for (int lado = 0; lado < 2; lado++) {
+                ativo[lado] = !fila[lado].vazia() && fila[lado].chaveMinima() < melhor;
+            }
+            if (!ativo[0] && !ativo[1]) break;
+            int lado = (ativo[0] && (!ativo[1] || fila[0].chaveMinima() <= fila[1].chaveMinima())) ? 0 : 1;
+
+            int u = fila[lado].removerMinimo();
+            r.assentados++;
+            if (dist[1 - lado][u] != INF && dist[0][u] + dist[1][u] < melhor) {
+                melhor = dist[0][u] + dist[1][u];
+                encontro = u;
+            }
+
+            // Stall-on-demand: se um vértice mais alto já chega a u por menos, dist[u]
+            // não é a distância real e expandir u só espalharia valores ruins
+            if (parado(lado, u)) continue;
+
+            for (std::uint64_t e = h.offsets[u]; e < h.offsets[u + 1]; e++) {
+                int v = h.destinos[e];
+                double nova = dist[lado][u] + h.pesos[e];
+                if (nova < dist[lado][v]) {
+                    if (dist[lado][v] == INF) tocados[lado].push_back(v);
+                    dist[lado][v] = nova;
+                    arestaAnterior[lado][v] = e;
+                    fila[lado].inserirOuReduzir(v, nova);
+                }
+            }
+        }
+
+        if (encontro >= 0) {
+            r.dist = melhor;
+            // Subida de s até o encontro (arestas na ordem inversa) ...
+            std::vector<std::uint64_t> subida;
+            for (int v = encontro; v != s; v = origemDe(arestaAnterior[0][v])) {
+                subida.push_back(arestaAnterior[0][v]);
+            }
+            r.caminho.push_back(s);
+            for (auto it = subida.rbegin(); it != subida.rend(); ++it) {
+                desempacotar(origemDe(*it), h.destinos[*it], *it, r.caminho);
+            }
+            // ... e descida do encontro até t (cada aresta percorrida ao contrário)
+            for (int v = encontro; v != t;) {
+                std::uint64_t e = arestaAnterior[1][v];
+                int anterior = origemDe(e);
+                desempacotar(v, anterior, e, r.caminho);
+                v = anterior;
+            }
+        }
+
+        reiniciar();
+        r.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        return r;
+    }
+};
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef JOHNSON_HPP
+#define JOHNSON_HPP
+
+// Algoritmo de Johnson para caminhos mínimos entre todos os pares em grafos esparsos.
+//
+// Bellman-Ford a partir de uma fonte virtual (ligada a todos com peso 0) dá potenciais h
+// tais que w'(u, v) = w(u, v) + h[u] - h[v] >= 0. Depois roda um Dijkstra por origem,
+// em paralelo, e desfaz a reponderação: d(s, v) = d'(s, v) - h[s] + h[v].
+// Com pesos não negativos os potenciais são todos 0 e os pesos ficam exatamente iguais.
+//
+// As linhas saem em lotes e em ordem, então a memória é O(lote * n) em vez de O(n²).
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include "grafo.hpp"
+#include "filas_prioridade.hpp"
+#include "paralelo.hpp"
+
+enum class MetodoAPSP { FLOYD_WARSHALL, JOHNSON };
+
+// Johnson compensa quando (arestas dirigidas + n log2 n) * JOHNSON_CUSTO_RELATIVO < n²:
+// cada relaxamento ou remoção do heap custa dezenas de vezes uma célula do min-plus
+// vetorizado. Com n = 1500 o ponto de virada fica perto de grau médio 60.
+const double JOHNSON_CUSTO_RELATIVO = 24.0;
+
+// Linhas calculadas por thread antes de cada entrega
+const int JOHNSON_LINHAS_POR_THREAD = 16;
+
+inline const char* nomeMetodoAPSP(MetodoAPSP metodo) {
+    return metodo == MetodoAPSP::JOHNSON ? "johnson" : "floyd-warshall";
+}
+
+// Pela densidade; GRAFO_APSP=fw|johnson força um dos dois
+inline MetodoAPSP escolherMetodoAPSP(const Grafo& grafo, int n) {
+    const char* pedido = std::getenv("GRAFO_APSP");
+    std::string p = pedido ? pedido : "";
+    if (p == "fw") return MetodoAPSP::FLOYD_WARSHALL;
+    if (p == "johnson") return MetodoAPSP::JOHNSON;
+    if (n < 2) return MetodoAPSP::FLOYD_WARSHALL;
+    double arestasDirigidas = 2.0 * grafo.qtdArestas();
+    double custoJohnson = (arestasDirigidas + n * std::log2(static_cast<double>(n))) * JOHNSON_CUSTO_RELATIVO;
+    return custoJohnson < static_cast<double>(n) * n ? MetodoAPSP::JOHNSON : MetodoAPSP::FLOYD_WARSHALL;
+}
+
+// Bellman-Ford da fonte virtual. h fica indexado pelo vértice (0..idMaximo).
+// Retorna false se houver ciclo negativo (num grafo não-dirigido, qualquer aresta negativa).
+inline bool potenciaisJohnson(const Grafo& grafo, std::vector<double>& h, int& rodadas) {
+    int tamanho = grafo.idMaximo() + 1;
+    h.assign(tamanho, 0.0);
+    for (rodadas = 1; rodadas <= tamanho; rodadas++) {
+        bool mudou = false;
+        for (int u = 0; u < tamanho; u++) {
+            auto vizinhos = grafo.vizinhanca(u);
+            auto pesos = grafo.pesosVizinhanca(u);
+            for (std::size_t i = 0; i < vizinhos.size(); i++) {
+                double nova = h[u] + pesos[i];
+                if (nova < h[vizinhos[i]]) {
+                    h[vizinhos[i]] = nova;
+                    mudou = true;
+                }
+            }
+        }
+        if (!mudou) return true;
+    }
+    return false;
+}
+
+namespace johnson_detalhe {
+
+// Dijkstra de s com os pesos reponderados, até assentar todos os `alvos` marcados;
+// dist volta toda a inf ao final
+inline void linhaDijkstra(const Grafo& grafo, const std::vector<double>& h, int s,
+                          const std::vector<int>& vertices, const std::vector<char>& alvo, int alvos,
+                          HeapQuaternario& heap, std::vector<double>& dist, std::vector<int>& tocados,
+                          double* linha) {
+    dist[s] = 0;
+    tocados.push_back(s);
+    heap.inserirOuReduzir(s, 0.0);
+    int assentados = 0;
+    while (!heap.vazia()) {
+        int u = heap.removerMinimo();
+        if (alvo[u] && ++assentados == alvos) break;
+        double du = dist[u];
+        auto vizinhos = grafo.vizinhanca(u);
+        auto pesos = grafo.pesosVizinhanca(u);
+        for (std::size_t i = 0; i < vizinhos.size(); i++) {
+            int v = vizinhos[i];
+            // Com potenciais exatos w' >= 0; o max só absorve arredondamento
+            double nova = du + std::max(0.0, pesos[i] + h[u] - h[v]);
+            if (nova < dist[v]) {
+                if (dist[v] == std::numeric_limits<double>::infinity()) tocados.push_back(v);
+                dist[v] = nova;
+                heap.inserirOuReduzir(v, nova);
+            }
+        }
+    }
+    for (std::size_t j = 0; j < vertices.size(); j++) {
+        double d = dist[vertices[j]];
+        linha[j] = d == std::numeric_limits<double>::infinity() ? d : d - h[s] + h[vertices[j]];
+    }
+    heap.limpar();
+    for (int v : tocados) dist[v] = std::numeric_limits<double>::infinity();
+    tocados.clear();
+}
+
+} // namespace johnson_detalhe
+
+// Distâncias de vertices[i] para todos os vertices[j], entregues em ordem crescente de i
+// como linhaPronta(i, linha), com linha[j] = d(vertices[i], vertices[j]). vertices pode
+// ser um subconjunto do grafo (Dijkstra multi-fonte entre eles).
+// h vem de potenciaisJohnson(). numThreads = 0 usa todos os núcleos.
+template <typename F>
+void johnson(const Grafo& grafo, const std::vector<int>& vertices, const std::vector<double>& h,
+             unsigned numThreads, F linhaPronta) {
+    numThreads = threadsEfetivas(numThreads);
+    int n = vertices.size();
+    int tamanho = grafo.idMaximo() + 1;
+    if (n == 0) return;
+    int lote = std::min<int>(n, static_cast<int>(numThreads) * JOHNSON_LINHAS_POR_THREAD);
+    std::vector<double> linhas(static_cast<std::size_t>(lote) * n);
+    // Cada Dijkstra para quando todas as colunas estão assentadas
+    std::vector<char> alvo(tamanho, 0);
+    int alvos = 0;
+    for (int v : vertices) {
+        if (v >= 0 && v < tamanho && !alvo[v]) {
+            alvo[v] = 1;
+            alvos++;
+        }
+    }
+
+    Barreira barreira(numThreads);
+    DivisaoTrabalho trabalho(numThreads);
+
+    auto trabalhar = [&](unsigned id) {
+        HeapQuaternario heap(tamanho);
+        std::vector<double> dist(tamanho, std::numeric_limits<double>::infinity());
+        std::vector<int> tocados;
+        std::size_t b;
+        for (int inicio = 0; inicio < n; inicio += lote) {
+            int fim = std::min(n, inicio + lote);
+            if (id == 0) trabalho.preparar(fim - inicio);
+            barreira.esperar();
+            while (trabalho.pegar(id, b)) {
+                johnson_detalhe::linhaDijkstra(grafo, h, vertices[inicio + b], vertices, alvo, alvos, heap, dist,
+                                               tocados, linhas.data() + b * n);
+            }
+            barreira.esperar();
+            if (id == 0) {
+                for (int i = inicio; i < fim; i++) {
+                    linhaPronta(i, static_cast<const double*>(linhas.data() + static_cast<std::size_t>(i - inicio) * n));
+                }
+            }
+            barreira.esperar();
+        }
+    };
+    emParalelo(numThreads, trabalhar);
+}
+
+#endif
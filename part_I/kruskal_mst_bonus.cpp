@@ -1,86 +1,61 @@
 #include <iostream>
 #include <vector>
+#include <string>
 #include <algorithm>
 #include "grafo.hpp"
+#include "arvore_geradora.hpp"
+#include "paralelo.hpp"
 
-// Estrutura Union-Find (Disjoint Set Union - DSU)
-class DSU {
-private:
-    std::vector<int> parent, rank;
-public:
-    DSU(int n) {
-        parent.resize(n + 1);
-        rank.resize(n + 1, 0);
-        for (int i = 1; i <= n; i++) parent[i] = i;
-    }
-    int find(int x) {
-        if (parent[x] != x) parent[x] = find(parent[x]);
-        return parent[x];
-    }
-    bool unite(int x, int y) {
-        int rx = find(x), ry = find(y);
-        if (rx == ry) return false;
-        if (rank[rx] < rank[ry]) std::swap(rx, ry);
-        parent[ry] = rx;
-        if (rank[rx] == rank[ry]) rank[rx]++;
-        return true;
-    }
-};
-
-struct Aresta {
-    int u, v;
-    double w;
-};
-
-// Implementação do Kruskal
-std::pair<double, std::vector<Aresta>> kruskal(const Grafo& grafo) {
-    int n = grafo.qtdVertices();
-    std::vector<Aresta> arestas;
+// Kruskal (Filter-Kruskal de arvore_geradora.hpp) sobre as arestas u < v do CSR
+ResultadoMST kruskal(const Grafo& grafo, unsigned threads) {
+    int tamanho = grafo.idMaximo() + 1;
+    std::vector<ArestaMST> arestas;
+    arestas.reserve(grafo.qtdArestas());
 
     // monta lista de arestas
-    for (int u = 1; u <= n; u++) {
-        for (int v : grafo.vizinhos(u)) {
+    for (int u = 0; u < tamanho; u++) {
+        auto vizinhos = grafo.vizinhanca(u);
+        auto pesos = grafo.pesosVizinhanca(u);
+        for (std::size_t i = 0; i < vizinhos.size(); i++) {
+            int v = vizinhos[i];
             if (u < v) { // evita duplicar aresta (grafo não direcionado)
-                double w = grafo.peso(u, v);
-                arestas.push_back({u, v, w});
+                arestas.push_back({pesos[i], static_cast<std::uint32_t>(u), static_cast<std::uint32_t>(v)});
             }
         }
     }
 
-    // ordena por peso
-    std::sort(arestas.begin(), arestas.end(), [](const Aresta& a, const Aresta& b) {
-        return a.w < b.w;
-    });
-
-    DSU dsu(n);
-    double peso_total = 0;
-    std::vector<Aresta> mst;
-
-    for (const auto& e : arestas) {
-        if (dsu.unite(e.u, e.v)) {
-            peso_total += e.w;
-            mst.push_back(e);
-        }
-    }
-
-    return {peso_total, mst};
+    return arvoreGeradoraMinima(std::max(tamanho, 0), arestas, threads);
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Uso: " << argv[0] << " <arquivo_grafo>" << std::endl;
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Uso: " << argv[0] << " <arquivo_grafo> [<threads>]" << std::endl;
         return 1;
     }
 
     std::string arquivo = argv[1];
+    unsigned threads = 0;
+    if (argc == 3 && !lerThreads(argv[2], threads)) {
+        std::cerr << "Erro: número de threads inválido." << std::endl;
+        return 1;
+    }
     Grafo grafo(arquivo);
+    grafo.compactar();
+
+    auto resultado = kruskal(grafo, threads);
+    if (estatisticasAtivas()) {
+        std::cerr << "[kruskal] arestas=" << grafo.qtdArestas()
+                  << " ordenadas=" << resultado.ordenadas
+                  << " descartadas=" << resultado.descartadas
+                  << " particoes=" << resultado.particoes
+                  << " threads=" << resultado.threads
+                  << " tempo=" << resultado.segundos * 1000.0 << " ms" << std::endl;
+    }
 
-    auto [peso_total, mst] = kruskal(grafo);
-
-    std::cout << "Peso total = " << peso_total << std::endl;
+    std::cout << "Peso total = " << resultado.pesoTotal << std::endl;
     std::cout << "Arestas:" << std::endl;
-    for (auto& e : mst) {
-        std::cout << e.u << "-" << e.v << " (" << e.w << ")" << std::endl;
+    for (auto& e : resultado.arestas) {
+        std::cout << e.u << "-" << e.v << " (" << e.peso << ")" << std::endl;
     }
 
     return 0;
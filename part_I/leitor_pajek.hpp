@@ -0,0 +1,356 @@
+#ifndef LEITOR_PAJEK_HPP
+#define LEITOR_PAJEK_HPP
+
+// Leitor de arquivos Pajek (.net) compartilhado pelos Grafo das três partes.
+//
+// O arquivo é mapeado em memória (mmap) e varrido sem cópias: as seções
+// *vertices / *edges / *arcs são localizadas direto no buffer mapeado e os
+// números são convertidos com std::from_chars. Cada seção de arestas é
+// dividida em blocos (sempre em fronteira de linha) que são lidos em paralelo,
+// um por thread, cada um direto na sua fatia dos vetores finais.
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <charconv>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <iostream>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Estatísticas (tempo, MB/s, contadores) vão para stderr quando
+// a variável de ambiente GRAFO_ESTATISTICAS está definida e diferente de "0".
+inline bool estatisticasAtivas() {
+    const char* valor = std::getenv("GRAFO_ESTATISTICAS");
+    return valor != nullptr && *valor != '\0' && *valor != '0';
+}
+
+// Arquivo somente-leitura mapeado em memória (RAII).
+// sequencial = true avisa o kernel que o arquivo será varrido do início ao fim.
+class ArquivoMapeado {
+private:
+    const char* dados;
+    std::size_t tamanho;
+#ifdef _WIN32
+    std::vector<char> buffer;
+#else
+    void* base;
+#endif
+    bool ok;
+
+public:
+    explicit ArquivoMapeado(const std::string& caminho, bool sequencial = true)
+        : dados(nullptr), tamanho(0), ok(false) {
+#ifdef _WIN32
+        (void)sequencial;
+        std::ifstream arquivo(caminho, std::ios::binary);
+        if (!arquivo.is_open()) return;
+        buffer.assign(std::istreambuf_iterator<char>(arquivo), std::istreambuf_iterator<char>());
+        dados = buffer.data();
+        tamanho = buffer.size();
+        ok = true;
+#else
+        base = nullptr;
+        int fd = ::open(caminho.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            return;
+        }
+        tamanho = static_cast<std::size_t>(info.st_size);
+        if (tamanho > 0) {
+            base = ::mmap(nullptr, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (base == MAP_FAILED) {
+                base = nullptr;
+                ::close(fd);
+                return;
+            }
+            if (sequencial) {
+                ::madvise(base, tamanho, MADV_SEQUENTIAL);
+            }
+            dados = static_cast<const char*>(base);
+        }
+        ::close(fd); // o mapeamento continua válido sem o descritor
+        ok = true;
+#endif
+    }
+
+    ~ArquivoMapeado() {
+#ifndef _WIN32
+        if (base != nullptr) {
+            ::munmap(base, tamanho);
+        }
+#endif
+    }
+
+    ArquivoMapeado(const ArquivoMapeado&) = delete;
+    ArquivoMapeado& operator=(const ArquivoMapeado&) = delete;
+
+    bool aberto() const { return ok; }
+    const char* inicio() const { return dados; }
+    const char* fim() const { return dados + tamanho; }
+    std::size_t bytes() const { return tamanho; }
+};
+
+// Trecho contíguo do vetor de arestas que veio de uma mesma seção do arquivo
+struct SecaoArestas {
+    bool dirigida;          // *arcs (true) ou *edges (false)
+    std::size_t inicio;     // primeira aresta da seção
+    std::size_t fim;        // uma após a última
+};
+
+// Conteúdo de um .net já convertido (vértices 1-based, como no arquivo)
+struct ConteudoPajek {
+    bool aberto = false;
+    int numVertices = 0;
+    std::vector<int> indices;          // índice de cada linha de vértice
+    std::vector<std::string> rotulos;  // resto da linha, sem espaços nas pontas
+    std::vector<int> origens;
+    std::vector<int> destinos;
+    std::vector<double> pesos;
+    std::vector<char> temPeso;         // 1 se a linha trazia o terceiro campo
+    std::vector<SecaoArestas> secoes;
+    std::size_t bytes = 0;
+    double segundos = 0.0;
+    unsigned threads = 1;              // maior número de blocos lidos em paralelo
+
+    std::size_t numArestas() const { return origens.size(); }
+
+    double mbPorSegundo() const {
+        return segundos > 0.0 ? (bytes / 1e6) / segundos : 0.0;
+    }
+};
+
+namespace pajek_detalhe {
+
+inline bool espaco(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline const char* pularEspacos(const char* p, const char* fim) {
+    while (p < fim && espaco(*p)) p++;
+    return p;
+}
+
+inline const char* fimDaLinha(const char* p, const char* fim) {
+    const void* nl = std::memchr(p, '\n', fim - p);
+    return nl ? static_cast<const char*>(nl) : fim;
+}
+
+// A linha começa com a palavra-chave inteira (sem diferenciar maiúsculas), seguida de
+// espaço ou do fim da linha: "*edgeslist" não é "*edges"
+inline bool comecaCom(const char* p, const char* fim, const char* chave) {
+    for (; *chave; chave++, p++) {
+        if (p >= fim || std::tolower(static_cast<unsigned char>(*p)) != *chave) return false;
+    }
+    return p == fim || espaco(*p);
+}
+
+// Início da primeira linha em [p, fim) cujo primeiro caractere não-espaço é '*', ou fim.
+// p está no começo de uma linha. Só os '*' são visitados (memchr), não cada linha.
+inline const char* proximaSecao(const char* p, const char* fim) {
+    const char* q = p;
+    while (q < fim) {
+        const void* achado = std::memchr(q, '*', fim - q);
+        if (!achado) return fim;
+        const char* linha = static_cast<const char*>(achado);
+        while (linha > p && espaco(linha[-1])) linha--;
+        if (linha == p || linha[-1] == '\n') return linha;
+        q = static_cast<const char*>(achado) + 1;
+    }
+    return fim;
+}
+
+// Linhas que começam em [p, fim): limite para as arestas de um bloco
+inline std::size_t contarLinhas(const char* p, const char* fim) {
+    std::size_t linhas = 0;
+    while (p < fim) {
+        p = fimDaLinha(p, fim) + 1;
+        linhas++;
+    }
+    return linhas;
+}
+
+// Lê as linhas "u v [peso]" que começam em [p, fim) para as posições de conteudo a partir
+// de pos; devolve quantas foram escritas
+inline std::size_t lerBloco(const char* p, const char* fim, ConteudoPajek& conteudo, std::size_t pos) {
+    std::size_t inicio = pos;
+    while (p < fim) {
+        const char* eol = fimDaLinha(p, fim);
+        const char* q = pularEspacos(p, eol);
+        int u, v;
+        auto r1 = std::from_chars(q, eol, u);
+        if (r1.ec == std::errc()) {
+            q = pularEspacos(r1.ptr, eol);
+            auto r2 = std::from_chars(q, eol, v);
+            if (r2.ec == std::errc()) {
+                q = pularEspacos(r2.ptr, eol);
+                double w = 1.0;
+                auto r3 = std::from_chars(q, eol, w);
+                bool lido = r3.ec == std::errc();
+                conteudo.origens[pos] = u;
+                conteudo.destinos[pos] = v;
+                conteudo.pesos[pos] = lido ? w : 1.0;
+                conteudo.temPeso[pos] = lido ? 1 : 0;
+                pos++;
+            }
+        }
+        p = eol + 1;
+    }
+    return pos - inicio;
+}
+
+// Lê uma seção de arestas em paralelo e anexa ao conteúdo, na ordem do arquivo
+inline void lerSecaoArestas(const char* inicio, const char* fim, unsigned numThreads,
+                            ConteudoPajek& conteudo) {
+    // Blocos muito pequenos não compensam o custo de criar threads
+    const std::size_t minimoPorBloco = 1 << 20;
+    std::size_t tamanho = fim - inicio;
+    unsigned blocos = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(numThreads, tamanho / minimoPorBloco)));
+
+    // Fronteiras dos blocos, sempre logo após um '\n'
+    std::vector<const char*> cortes(blocos + 1);
+    cortes[0] = inicio;
+    cortes[blocos] = fim;
+    for (unsigned b = 1; b < blocos; b++) {
+        const char* c = inicio + tamanho * b / blocos;
+        c = std::max(c, cortes[b - 1]);
+        c = fimDaLinha(c, fim);
+        cortes[b] = (c < fim) ? c + 1 : fim;
+    }
+
+    conteudo.threads = std::max(conteudo.threads, blocos);
+    auto emBlocos = [&](auto f) {
+        if (blocos == 1) {
+            f(0u);
+            return;
+        }
+        std::vector<std::thread> trabalhadores;
+        for (unsigned b = 0; b < blocos; b++) trabalhadores.emplace_back(f, b);
+        for (auto& t : trabalhadores) t.join();
+    };
+
+    // Cada bloco recebe uma fatia com uma posição por linha (o máximo de arestas que pode
+    // ter); os vetores finais crescem uma vez só, sem vetores intermediários por bloco
+    std::vector<std::size_t> fatia(blocos + 1, conteudo.origens.size());
+    emBlocos([&](unsigned b) { fatia[b + 1] = contarLinhas(cortes[b], cortes[b + 1]); });
+    for (unsigned b = 0; b < blocos; b++) fatia[b + 1] += fatia[b];
+    conteudo.origens.resize(fatia[blocos]);
+    conteudo.destinos.resize(fatia[blocos]);
+    conteudo.pesos.resize(fatia[blocos]);
+    conteudo.temPeso.resize(fatia[blocos]);
+
+    std::vector<std::size_t> lidas(blocos);
+    emBlocos([&](unsigned b) { lidas[b] = lerBloco(cortes[b], cortes[b + 1], conteudo, fatia[b]); });
+
+    // Linhas sem aresta (vazias, comentários) deixam buracos no fim de cada fatia
+    std::size_t total = fatia[0];
+    for (unsigned b = 0; b < blocos; b++) {
+        if (total != fatia[b]) {
+            std::copy_n(conteudo.origens.begin() + fatia[b], lidas[b], conteudo.origens.begin() + total);
+            std::copy_n(conteudo.destinos.begin() + fatia[b], lidas[b], conteudo.destinos.begin() + total);
+            std::copy_n(conteudo.pesos.begin() + fatia[b], lidas[b], conteudo.pesos.begin() + total);
+            std::copy_n(conteudo.temPeso.begin() + fatia[b], lidas[b], conteudo.temPeso.begin() + total);
+        }
+        total += lidas[b];
+    }
+    conteudo.origens.resize(total);
+    conteudo.destinos.resize(total);
+    conteudo.pesos.resize(total);
+    conteudo.temPeso.resize(total);
+}
+
+} // namespace pajek_detalhe
+
+// Lê um arquivo .net inteiro. numThreads = 0 usa todos os núcleos disponíveis.
+inline ConteudoPajek lerPajek(const std::string& caminho, unsigned numThreads = 0) {
+    using namespace pajek_detalhe;
+
+    ConteudoPajek conteudo;
+    auto t0 = std::chrono::steady_clock::now();
+
+    ArquivoMapeado arquivo(caminho);
+    if (!arquivo.aberto()) {
+        return conteudo;
+    }
+    conteudo.aberto = true;
+    conteudo.bytes = arquivo.bytes();
+
+    if (numThreads == 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    enum Secao { NENHUMA, VERTICES, ARESTAS, ARCOS, OUTRA };
+    Secao atual = NENHUMA;
+    const char* p = arquivo.inicio();
+    const char* fim = arquivo.fim();
+
+    while (p < fim) {
+        const char* eol = fimDaLinha(p, fim);
+        const char* q = pularEspacos(p, eol);
+
+        if (q < eol && *q == '*') {
+            if (comecaCom(q, eol, "*vertices")) {
+                atual = VERTICES;
+                const char* n = pularEspacos(q + 9, eol);
+                std::from_chars(n, eol, conteudo.numVertices);
+                conteudo.indices.reserve(conteudo.numVertices);
+                conteudo.rotulos.reserve(conteudo.numVertices);
+                p = eol + 1;
+            } else if (comecaCom(q, eol, "*edges") || comecaCom(q, eol, "*arcs")) {
+                atual = (q[1] == 'a' || q[1] == 'A') ? ARCOS : ARESTAS;
+                // A seção vai até a próxima linha que começa com '*'
+                const char* inicioSecao = (eol < fim) ? eol + 1 : fim;
+                const char* fimSecao = proximaSecao(inicioSecao, fim);
+                SecaoArestas secao{atual == ARCOS, conteudo.origens.size(), 0};
+                lerSecaoArestas(inicioSecao, fimSecao, numThreads, conteudo);
+                secao.fim = conteudo.origens.size();
+                conteudo.secoes.push_back(secao);
+                p = fimSecao;
+            } else {
+                atual = OUTRA;
+                p = eol + 1;
+            }
+            continue;
+        }
+
+        if (atual == VERTICES && q < eol) {
+            int indice;
+            auto r = std::from_chars(q, eol, indice);
+            if (r.ec == std::errc()) {
+                const char* a = pularEspacos(r.ptr, eol);
+                const char* b = eol;
+                while (b > a && espaco(b[-1])) b--;
+                conteudo.indices.push_back(indice);
+                conteudo.rotulos.emplace_back(a, b);
+            }
+        }
+        p = eol + 1;
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+    conteudo.segundos = std::chrono::duration<double>(t1 - t0).count();
+
+    if (estatisticasAtivas()) {
+        std::cerr << "[leitor] " << caminho << ": " << conteudo.bytes << " bytes, "
+                  << conteudo.numArestas() << " arestas, " << conteudo.threads << " threads, "
+                  << conteudo.segundos * 1000.0 << " ms, " << conteudo.mbPorSegundo() << " MB/s"
+                  << std::endl;
+    }
+    return conteudo;
+}
+
+#endif
@@ -0,0 +1,275 @@
+#ifndef PONTO_A_PONTO_HPP
+#define PONTO_A_PONTO_HPP
+
+// Consultas de caminho mínimo de s até um único t, com parada antecipada:
+//   - Dijkstra bidirecional: busca a partir de s e de t ao mesmo tempo e para quando
+//     topo(frente) + topo(trás) >= melhor caminho já visto;
+//   - A* com limites inferiores ALT (landmarks + desigualdade triangular):
+//     h(v) = max_L |d(L, t) - d(L, v)|, que é consistente, então cada vértice é
+//     assentado no máximo uma vez.
+// O grafo da parte I é não dirigido, então o grafo reverso é o próprio grafo.
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include "grafo.hpp"
+#include "dijkstra.hpp"
+#include "filas_prioridade.hpp"
+
+struct ResultadoPontoAPonto {
+    double dist = std::numeric_limits<double>::infinity();
+    std::vector<int> caminho;         // vazio se t é inalcançável
+    std::uint64_t assentados = 0;     // vértices removidos da(s) fila(s)
+    double segundos = 0.0;
+};
+
+inline ResultadoPontoAPonto dijkstraBidirecional(const Grafo& grafo, int s, int t) {
+    auto inicio = std::chrono::steady_clock::now();
+    const double INF = std::numeric_limits<double>::infinity();
+    int tamanho = grafo.idMaximo() + 1;
+
+    ResultadoPontoAPonto r;
+    if (s < 0 || s >= tamanho || t < 0 || t >= tamanho) return r;
+
+    // Índice 0 = busca a partir de s, 1 = busca a partir de t
+    std::vector<double> dist[2] = {std::vector<double>(tamanho, INF), std::vector<double>(tamanho, INF)};
+    std::vector<int> antecessor[2] = {std::vector<int>(tamanho, -1), std::vector<int>(tamanho, -1)};
+    HeapQuaternario fila[2] = {HeapQuaternario(tamanho), HeapQuaternario(tamanho)};
+
+    dist[0][s] = 0;
+    dist[1][t] = 0;
+    fila[0].inserirOuReduzir(s, 0);
+    fila[1].inserirOuReduzir(t, 0);
+
+    double melhor = (s == t) ? 0 : INF;
+    int encontro = (s == t) ? s : -1;
+
+    while (!fila[0].vazia() && !fila[1].vazia()) {
+        if (fila[0].chaveMinima() + fila[1].chaveMinima() >= melhor) break;
+
+        int lado = fila[0].chaveMinima() <= fila[1].chaveMinima() ? 0 : 1;
+        int outro = 1 - lado;
+        int u = fila[lado].removerMinimo();
+        r.assentados++;
+
+        auto vizinhos = grafo.vizinhanca(u);
+        auto pesos = grafo.pesosVizinhanca(u);
+        for (std::size_t i = 0; i < vizinhos.size(); i++) {
+            int v = vizinhos[i];
+            double nova = dist[lado][u] + pesos[i];
+            if (nova < dist[lado][v]) {
+                dist[lado][v] = nova;
+                antecessor[lado][v] = u;
+                fila[lado].inserirOuReduzir(v, nova);
+            }
+            if (dist[outro][v] != INF && nova + dist[outro][v] < melhor) {
+                melhor = nova + dist[outro][v];
+                encontro = v;
+            }
+        }
+    }
+
+    if (encontro >= 0) {
+        r.dist = melhor;
+        for (int v = encontro; v != -1; v = antecessor[0][v]) r.caminho.push_back(v);
+        std::reverse(r.caminho.begin(), r.caminho.end());
+        for (int v = antecessor[1][encontro]; v != -1; v = antecessor[1][v]) r.caminho.push_back(v);
+    }
+
+    r.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return r;
+}
+
+// Distâncias de cada landmark a todos os vértices: dist[l * tamanho + v]
+struct Landmarks {
+    int tamanho = 0;                  // idMaximo + 1 do grafo
+    std::uint64_t entradasCSR = 0;    // para reconhecer um arquivo de outro grafo
+    std::uint64_t assinatura = 0;     // ... ou do mesmo grafo com outros pesos
+    std::vector<int> vertices;
+    std::vector<double> dist;
+
+    int quantidade() const { return vertices.size(); }
+
+    // Limite inferior de d(v, t). A folga relativa de 1e-9 absorve o arredondamento
+    // das somas em double, para o limite nunca passar da distância real.
+    double limite(int v, int t) const {
+        double h = 0;
+        for (int l = 0; l < quantidade(); l++) {
+            const double* d = dist.data() + static_cast<std::size_t>(l) * tamanho;
+            if (std::isinf(d[v]) || std::isinf(d[t])) continue;
+            h = std::max(h, std::fabs(d[t] - d[v]));
+        }
+        return h * (1.0 - 1e-9);
+    }
+};
+
+inline std::uint64_t entradasCSR(const Grafo& grafo) {
+    return grafo.inicioVizinhanca(grafo.idMaximo()) + grafo.grau(grafo.idMaximo());
+}
+
+// Soma de verificação (FNV-1a por palavra de 64 bits) de graus, destinos e pesos do CSR:
+// muda se qualquer aresta ou peso mudar, mesmo com a mesma quantidade de entradas
+inline std::uint64_t assinaturaCSR(const Grafo& grafo) {
+    std::uint64_t h = 14695981039346656037ull;
+    auto misturar = [&](std::uint64_t x) { h = (h ^ x) * 1099511628211ull; };
+    for (int v = 0; v <= grafo.idMaximo(); v++) {
+        auto vizinhos = grafo.vizinhanca(v);
+        auto pesos = grafo.pesosVizinhanca(v);
+        misturar(vizinhos.size());
+        for (std::size_t i = 0; i < vizinhos.size(); i++) {
+            std::uint64_t bitsPeso;
+            std::memcpy(&bitsPeso, &pesos[i], sizeof(bitsPeso));
+            misturar(static_cast<std::uint32_t>(vizinhos[i]));
+            misturar(bitsPeso);
+        }
+    }
+    return h;
+}
+
+// Seleção "farthest": cada novo landmark é o vértice alcançável mais distante
+// dos landmarks já escolhidos. O primeiro parte do vértice de maior grau.
+inline Landmarks escolherLandmarks(const Grafo& grafo, int quantidade) {
+    Landmarks lm;
+    lm.tamanho = grafo.idMaximo() + 1;
+    lm.entradasCSR = entradasCSR(grafo);
+    lm.assinatura = assinaturaCSR(grafo);
+
+    int inicial = 1;
+    for (int v = 1; v < lm.tamanho; v++) {
+        if (grafo.grau(v) > grafo.grau(inicial)) inicial = v;
+    }
+    std::vector<double> menorDist(lm.tamanho, std::numeric_limits<double>::infinity());
+    auto primeira = dijkstra(grafo, inicial).dist;
+    int candidato = inicial;
+    for (int v = 1; v < lm.tamanho; v++) {
+        if (!std::isinf(primeira[v]) && primeira[v] > primeira[candidato]) candidato = v;
+    }
+
+    for (int l = 0; l < quantidade && l < lm.tamanho - 1; l++) {
+        auto d = dijkstra(grafo, candidato).dist;
+        lm.vertices.push_back(candidato);
+        lm.dist.insert(lm.dist.end(), d.begin(), d.end());
+
+        int proximo = -1;
+        for (int v = 1; v < lm.tamanho; v++) {
+            if (!std::isinf(d[v])) menorDist[v] = std::min(menorDist[v], d[v]);
+            if (std::isinf(menorDist[v]) || menorDist[v] == 0) continue;
+            if (proximo < 0 || menorDist[v] > menorDist[proximo]) proximo = v;
+        }
+        if (proximo < 0) break;
+        candidato = proximo;
+    }
+    return lm;
+}
+
+// Arquivo <grafo>.alt: "ALT2", tamanho, entradasCSR, assinatura, quantidade, vertices[], dist[]
+inline bool salvarLandmarks(const std::string& caminho, const Landmarks& lm) {
+    std::ofstream saida(caminho, std::ios::binary | std::ios::trunc);
+    if (!saida.is_open()) return false;
+    std::int64_t cab[4] = {lm.tamanho, static_cast<std::int64_t>(lm.entradasCSR),
+                           static_cast<std::int64_t>(lm.assinatura), lm.quantidade()};
+    saida.write("ALT2", 4);
+    saida.write(reinterpret_cast<const char*>(cab), sizeof(cab));
+    saida.write(reinterpret_cast<const char*>(lm.vertices.data()), lm.vertices.size() * sizeof(int));
+    saida.write(reinterpret_cast<const char*>(lm.dist.data()), lm.dist.size() * sizeof(double));
+    return static_cast<bool>(saida);
+}
+
+inline bool carregarLandmarks(const std::string& caminho, const Grafo& grafo, Landmarks& lm) {
+    std::ifstream entrada(caminho, std::ios::binary);
+    if (!entrada.is_open()) return false;
+    char magica[4];
+    std::int64_t cab[4];
+    entrada.read(magica, 4);
+    entrada.read(reinterpret_cast<char*>(cab), sizeof(cab));
+    if (!entrada || std::memcmp(magica, "ALT2", 4) != 0) return false;
+    if (cab[0] != grafo.idMaximo() + 1 || static_cast<std::uint64_t>(cab[1]) != entradasCSR(grafo) ||
+        static_cast<std::uint64_t>(cab[2]) != assinaturaCSR(grafo)) {
+        return false; // landmarks de outra versão do grafo (arestas ou pesos)
+    }
+    // Quantidade em 1..tamanho e limitada pelo que cabe no arquivo antes de alocar (cada
+    // landmark: o vértice e tamanho distâncias)
+    std::streamoff inicio = 4 + sizeof(cab);
+    entrada.seekg(0, std::ios::end);
+    std::int64_t restante = static_cast<std::int64_t>(entrada.tellg()) - inicio;
+    entrada.seekg(inicio);
+    if (!entrada || cab[3] <= 0 || cab[3] > cab[0] ||
+        cab[3] > restante / static_cast<std::int64_t>(sizeof(int) + cab[0] * sizeof(double))) {
+        return false;
+    }
+    lm.tamanho = static_cast<int>(cab[0]);
+    lm.entradasCSR = static_cast<std::uint64_t>(cab[1]);
+    lm.assinatura = static_cast<std::uint64_t>(cab[2]);
+    lm.vertices.resize(cab[3]);
+    lm.dist.resize(static_cast<std::size_t>(cab[3]) * lm.tamanho);
+    entrada.read(reinterpret_cast<char*>(lm.vertices.data()), lm.vertices.size() * sizeof(int));
+    entrada.read(reinterpret_cast<char*>(lm.dist.data()), lm.dist.size() * sizeof(double));
+    if (!entrada) return false;
+    for (int v : lm.vertices) {
+        if (v < 0 || v >= lm.tamanho) return false;
+    }
+    return true;
+}
+
+// Carrega <arquivoGrafo>.alt ou, se não existir/estiver desatualizado, calcula e grava
+inline Landmarks landmarksDoGrafo(const Grafo& grafo, const std::string& arquivoGrafo, int quantidade = 16) {
+    Landmarks lm;
+    std::string caminho = arquivoGrafo + ".alt";
+    if (carregarLandmarks(caminho, grafo, lm)) return lm;
+    lm = escolherLandmarks(grafo, quantidade);
+    if (!salvarLandmarks(caminho, lm)) {
+        std::cerr << "Aviso: não foi possível gravar " << caminho << std::endl;
+    }
+    return lm;
+}
+
+inline ResultadoPontoAPonto aEstrelaALT(const Grafo& grafo, int s, int t, const Landmarks& lm) {
+    auto inicio = std::chrono::steady_clock::now();
+    const double INF = std::numeric_limits<double>::infinity();
+    int tamanho = grafo.idMaximo() + 1;
+
+    ResultadoPontoAPonto r;
+    if (s < 0 || s >= tamanho || t < 0 || t >= tamanho) return r;
+
+    std::vector<double> dist(tamanho, INF);
+    std::vector<int> antecessor(tamanho, -1);
+    HeapQuaternario fila(tamanho);
+
+    dist[s] = 0;
+    fila.inserirOuReduzir(s, lm.limite(s, t));
+
+    while (!fila.vazia()) {
+        int u = fila.removerMinimo();
+        r.assentados++;
+        if (u == t) break;
+
+        auto vizinhos = grafo.vizinhanca(u);
+        auto pesos = grafo.pesosVizinhanca(u);
+        for (std::size_t i = 0; i < vizinhos.size(); i++) {
+            int v = vizinhos[i];
+            double nova = dist[u] + pesos[i];
+            if (nova < dist[v]) {
+                dist[v] = nova;
+                antecessor[v] = u;
+                fila.inserirOuReduzir(v, nova + lm.limite(v, t));
+            }
+        }
+    }
+
+    if (dist[t] != INF) {
+        r.dist = dist[t];
+        for (int v = t; v != -1; v = antecessor[v]) r.caminho.push_back(v);
+        std::reverse(r.caminho.begin(), r.caminho.end());
+    }
+
+    r.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    return r;
+}
+
+#endif
@@ -0,0 +1,278 @@
+#ifndef ALCANCE_HPP
+#define ALCANCE_HPP
+
+// Índice de alcançabilidade ("u alcança v?") sobre o grafo condensado das componentes
+// fortemente conexas.
+//
+// O grafo condensado é um DAG com uma linha por componente. Com os ids em ordem
+// topológica (os de Grafo::componentesFortementeConexas()), todo arco vai de um id menor
+// para um maior, e c só alcança ids >= c. O índice tem duas formas:
+//
+//   - fecho transitivo em bitset, quando cabe em ALCANCE_LIMITE_BITSET bytes: a linha de c
+//     é {c} OU as linhas dos sucessores, palavra a palavra. Só as palavras a partir de
+//     c / 64 são guardadas (o resto seria zero), o que corta a memória pela metade. As
+//     linhas são calculadas por altura (distância até um sumidouro), cada altura em
+//     paralelo. Consulta O(1);
+//   - rótulos de intervalo (GRAIL), para DAGs maiores: em cada uma de ALCANCE_ROTULOS
+//     DFS com ordem aleatória de filhos, c recebe [menor pós-ordem da subárvore, pós-ordem].
+//     Se c alcança d, o intervalo de d está contido no de c; se algum não está, a resposta
+//     é não em O(1). Senão, uma DFS podada pelos mesmos rótulos e pela ordem topológica
+//     confirma.
+
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include "grafo.hpp"
+#include "paralelo.hpp"
+
+// Acima disso (em bytes) o fecho transitivo dá lugar aos rótulos de intervalo
+const std::uint64_t ALCANCE_LIMITE_BITSET = std::uint64_t(1) << 30;
+const int ALCANCE_ROTULOS = 3;
+
+// Arcos entre componentes, sem repetição e sem laços, em CSR por componente
+struct Condensacao {
+    std::vector<int> inicio;
+    std::vector<int> destinos;
+
+    int quantidade() const {
+        return inicio.empty() ? 0 : static_cast<int>(inicio.size()) - 1;
+    }
+};
+
+inline Condensacao condensar(const Grafo& g, const ComponentesFortes& componentes, unsigned numThreads = 0) {
+    unsigned threads = threadsEfetivas(numThreads);
+    int k = componentes.quantidade();
+    Condensacao dag;
+    dag.inicio.assign(k + 1, 0);
+
+    // Duas passadas por faixa de componentes (contar, preencher), com marcas próprias
+    auto percorrer = [&](int inicio, int fim, bool preencher) {
+        std::vector<int> marca(k, -1);
+        for (int c = inicio; c < fim; c++) {
+            int p = preencher ? dag.inicio[c] : 0;
+            for (int i = componentes.inicio[c]; i < componentes.inicio[c + 1]; i++) {
+                for (const auto& aresta : g.adjacentes(componentes.vertices[i])) {
+                    int d = componentes.componente[aresta.destino];
+                    if (d == c || marca[d] == c) continue;
+                    marca[d] = c;
+                    if (preencher) {
+                        dag.destinos[p++] = d;
+                    } else {
+                        dag.inicio[c + 1]++;
+                    }
+                }
+            }
+            if (preencher) std::sort(dag.destinos.begin() + dag.inicio[c], dag.destinos.begin() + p);
+        }
+    };
+    emFaixas(k, threads, [&](int inicio, int fim) { percorrer(inicio, fim, false); });
+    for (int c = 0; c < k; c++) dag.inicio[c + 1] += dag.inicio[c];
+    dag.destinos.resize(dag.inicio[k]);
+    emFaixas(k, threads, [&](int inicio, int fim) { percorrer(inicio, fim, true); });
+    return dag;
+}
+
+class IndiceAlcance {
+private:
+    std::vector<int> componente;
+    Condensacao dag;
+    bool usaBitset = false;
+
+    // Fecho: linha c ocupa as palavras [c / 64, numPalavras) a partir de linha[c]
+    int numPalavras = 0;
+    std::vector<std::uint64_t> linha;
+    std::vector<std::uint64_t> bits;
+
+    // Intervalos: [menor[r * k + c], posOrdem[r * k + c]] na DFS r
+    std::vector<int> menor;
+    std::vector<int> posOrdem;
+    mutable std::vector<int> visitado;
+    mutable std::vector<int> pilha;
+    mutable int carimbo = 0;
+
+    double segundos = 0.0;
+
+    void construirFecho(unsigned threads) {
+        int k = dag.quantidade();
+        linha.assign(k + 1, 0);
+        for (int c = 0; c < k; c++) linha[c + 1] = linha[c] + (numPalavras - c / 64);
+        bits.assign(linha[k], 0);
+
+        // Altura 0 são os sumidouros; cada altura só lê linhas de alturas menores
+        std::vector<int> altura(k, 0);
+        int maxAltura = 0;
+        for (int c = k - 1; c >= 0; c--) {
+            for (int i = dag.inicio[c]; i < dag.inicio[c + 1]; i++) {
+                altura[c] = std::max(altura[c], altura[dag.destinos[i]] + 1);
+            }
+            maxAltura = std::max(maxAltura, altura[c]);
+        }
+        std::vector<int> inicioAltura(maxAltura + 2, 0);
+        for (int c = 0; c < k; c++) inicioAltura[altura[c] + 1]++;
+        for (int h = 0; h <= maxAltura; h++) inicioAltura[h + 1] += inicioAltura[h];
+        std::vector<int> porAltura(k);
+        std::vector<int> proximo(inicioAltura.begin(), inicioAltura.end() - 1);
+        for (int c = 0; c < k; c++) porAltura[proximo[altura[c]]++] = c;
+
+        for (int h = 0; h <= maxAltura; h++) {
+            int base = inicioAltura[h];
+            emFaixas(inicioAltura[h + 1] - base, threads, [&](int inicio, int fim) {
+                for (int j = base + inicio; j < base + fim; j++) {
+                    int c = porAltura[j];
+                    std::uint64_t* minha = &bits[linha[c]];
+                    int primeira = c / 64;
+                    minha[0] |= std::uint64_t(1) << (c % 64);
+                    for (int i = dag.inicio[c]; i < dag.inicio[c + 1]; i++) {
+                        int d = dag.destinos[i];
+                        // d > c: a linha de d começa na mesma palavra ou depois
+                        const std::uint64_t* dela = &bits[linha[d]];
+                        std::uint64_t* alvo = minha + (d / 64 - primeira);
+                        int tamanho = numPalavras - d / 64;
+                        for (int w = 0; w < tamanho; w++) alvo[w] |= dela[w];
+                    }
+                }
+            });
+        }
+    }
+
+    void construirRotulos(unsigned threads) {
+        int k = dag.quantidade();
+        menor.assign(static_cast<std::size_t>(ALCANCE_ROTULOS) * k, 0);
+        posOrdem.assign(static_cast<std::size_t>(ALCANCE_ROTULOS) * k, 0);
+        std::vector<int> grauEntrada(k, 0);
+        for (int d : dag.destinos) grauEntrada[d]++;
+
+        // Cada rotulagem é independente: uma por thread
+        emParalelo(std::min<unsigned>(threads, ALCANCE_ROTULOS), [&](unsigned id) {
+            for (int r = id; r < ALCANCE_ROTULOS; r += std::min<unsigned>(threads, ALCANCE_ROTULOS)) {
+                std::mt19937 gerador(12345 + r);
+                int* baixo = &menor[static_cast<std::size_t>(r) * k];
+                int* pos = &posOrdem[static_cast<std::size_t>(r) * k];
+                std::vector<int> ordem(dag.destinos);
+                for (int c = 0; c < k; c++) {
+                    std::shuffle(ordem.begin() + dag.inicio[c], ordem.begin() + dag.inicio[c + 1], gerador);
+                }
+                std::vector<int> raizes;
+                for (int c = 0; c < k; c++) {
+                    if (grauEntrada[c] == 0) raizes.push_back(c);
+                }
+                std::shuffle(raizes.begin(), raizes.end(), gerador);
+
+                std::vector<char> visto(k, 0);
+                std::vector<std::pair<int, int>> chamadas;
+                int contador = 0;
+                for (int raiz : raizes) {
+                    visto[raiz] = 1;
+                    baixo[raiz] = k;
+                    chamadas.push_back({raiz, dag.inicio[raiz]});
+                    while (!chamadas.empty()) {
+                        int c = chamadas.back().first;
+                        int& proxima = chamadas.back().second;
+                        if (proxima < dag.inicio[c + 1]) {
+                            int d = ordem[proxima++];
+                            if (visto[d]) {
+                                baixo[c] = std::min(baixo[c], baixo[d]);
+                            } else {
+                                visto[d] = 1;
+                                baixo[d] = k;
+                                chamadas.push_back({d, dag.inicio[d]});
+                            }
+                            continue;
+                        }
+                        chamadas.pop_back();
+                        pos[c] = contador++;
+                        baixo[c] = std::min(baixo[c], pos[c]);
+                        if (!chamadas.empty()) {
+                            int pai = chamadas.back().first;
+                            baixo[pai] = std::min(baixo[pai], baixo[c]);
+                        }
+                    }
+                }
+            }
+        });
+        visitado.assign(k, 0);
+    }
+
+    // Intervalo de d contido no de c em todas as rotulagens
+    bool contido(int c, int d) const {
+        std::size_t k = dag.quantidade();
+        for (int r = 0; r < ALCANCE_ROTULOS; r++) {
+            std::size_t base = r * k;
+            if (menor[base + d] < menor[base + c] || posOrdem[base + d] > posOrdem[base + c]) return false;
+        }
+        return true;
+    }
+
+public:
+    // componentes com ids em ordem topológica (Grafo::componentesFortementeConexas()).
+    // limiteBitset em bytes; numThreads = 0 usa todos os núcleos.
+    IndiceAlcance(const Grafo& g, const ComponentesFortes& componentes, unsigned numThreads = 0,
+                  std::uint64_t limiteBitset = ALCANCE_LIMITE_BITSET) {
+        auto inicio = std::chrono::steady_clock::now();
+        unsigned threads = threadsEfetivas(numThreads);
+        componente = componentes.componente;
+        dag = condensar(g, componentes, threads);
+        int k = dag.quantidade();
+        numPalavras = (k + 63) / 64;
+
+        // Palavras do fecho triangular: soma de numPalavras - c / 64
+        std::uint64_t palavras = 0;
+        for (int w = 0; w < numPalavras; w++) {
+            palavras += static_cast<std::uint64_t>(std::min(64, k - 64 * w)) * (numPalavras - w);
+        }
+        usaBitset = palavras * sizeof(std::uint64_t) <= limiteBitset;
+        if (usaBitset) {
+            construirFecho(threads);
+        } else {
+            construirRotulos(threads);
+        }
+        segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    }
+
+    // u e v são vértices (0-based). Não é seguro chamar de várias threads no modo intervalos.
+    bool alcanca(int u, int v) const {
+        int c = componente[u];
+        int d = componente[v];
+        if (c == d) return true;
+        if (c > d) return false;
+        if (usaBitset) {
+            return (bits[linha[c] + (d / 64 - c / 64)] >> (d % 64)) & 1;
+        }
+        if (!contido(c, d)) return false;
+
+        // DFS podada: só desce para e com e <= d cujo intervalo ainda contém o de d
+        if (++carimbo == 0) {
+            std::fill(visitado.begin(), visitado.end(), 0);
+            carimbo = 1;
+        }
+        pilha.clear();
+        pilha.push_back(c);
+        visitado[c] = carimbo;
+        while (!pilha.empty()) {
+            int x = pilha.back();
+            pilha.pop_back();
+            for (int i = dag.inicio[x]; i < dag.inicio[x + 1]; i++) {
+                int e = dag.destinos[i];
+                if (e == d) return true;
+                if (e > d || visitado[e] == carimbo || !contido(e, d)) continue;
+                visitado[e] = carimbo;
+                pilha.push_back(e);
+            }
+        }
+        return false;
+    }
+
+    const Condensacao& condensacao() const { return dag; }
+    bool fechoEmBitset() const { return usaBitset; }
+    double segundosConstrucao() const { return segundos; }
+
+    std::uint64_t bytes() const {
+        return (bits.size() + linha.size()) * sizeof(std::uint64_t) +
+               (menor.size() + posOrdem.size()) * sizeof(int) +
+               (dag.inicio.size() + dag.destinos.size() + componente.size()) * sizeof(int);
+    }
+};
+
+#endif
@@ -0,0 +1,255 @@
+#ifndef ARVORE_DINAMICA_HPP
+#define ARVORE_DINAMICA_HPP
+
+// Árvore (floresta) geradora mínima mantida sob inserções de arestas, sem recomputar.
+//
+// A floresta atual fica numa link-cut tree em que cada aresta da árvore é um nó próprio
+// entre as suas duas pontas, e cada nó guarda a aresta máxima da sua subárvore splay.
+// Inserir u-v custa O(log V) amortizado:
+//   - u e v em árvores diferentes: a aresta entra (link);
+//   - senão, se ela é menor que a máxima do caminho u..v na árvore, a máxima sai (cut)
+//     e ela entra; caso contrário é descartada.
+// A ordem é a (peso, u, v) de arvore_geradora.hpp, então a floresta é sempre a mesma
+// que o Kruskal daria para o grafo com todas as arestas já inseridas.
+//
+// Lotes maiores que V são mais baratos de uma vez: MST(G + lote) = MST(T + lote),
+// então o Filter-Kruskal roda só sobre as arestas da árvore e as do lote.
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "arvore_geradora.hpp"
+
+class ArvoreGeradoraDinamica {
+private:
+    struct No {
+        int filho[2] = {-1, -1};
+        int pai = -1;           // pai na splay ou, na raiz da splay, ponteiro de caminho
+        bool inverter = false;
+        int maximo = -1;        // nó-aresta de maior (peso, u, v) na subárvore splay
+    };
+
+    int numVertices;
+    // Nós 0..numVertices-1 são os vértices; os seguintes, as arestas da árvore
+    std::vector<No> nos;
+    std::vector<ArestaMST> arestaDoNo;
+    std::vector<char> ativo;
+    std::vector<int> livres;
+    double peso = 0.0;
+    std::size_t numArestas = 0;
+    std::vector<int> pilha;
+
+    bool ehAresta(int x) const { return x >= numVertices; }
+
+    const ArestaMST& aresta(int x) const { return arestaDoNo[x - numVertices]; }
+
+    int maiorDe(int a, int b) const {
+        if (a < 0) return b;
+        if (b < 0) return a;
+        return mst_detalhe::menor(aresta(a), aresta(b)) ? b : a;
+    }
+
+    bool ehRaizSplay(int x) const {
+        int p = nos[x].pai;
+        return p < 0 || (nos[p].filho[0] != x && nos[p].filho[1] != x);
+    }
+
+    void atualizar(int x) {
+        int m = ehAresta(x) ? x : -1;
+        for (int f : nos[x].filho) {
+            if (f >= 0) m = maiorDe(m, nos[f].maximo);
+        }
+        nos[x].maximo = m;
+    }
+
+    void empurrar(int x) {
+        if (!nos[x].inverter) return;
+        std::swap(nos[x].filho[0], nos[x].filho[1]);
+        for (int f : nos[x].filho) {
+            if (f >= 0) nos[f].inverter = !nos[f].inverter;
+        }
+        nos[x].inverter = false;
+    }
+
+    void girar(int x) {
+        int y = nos[x].pai;
+        int z = nos[y].pai;
+        int lado = nos[y].filho[1] == x;
+        if (!ehRaizSplay(y)) nos[z].filho[nos[z].filho[1] == y] = x;
+        nos[x].pai = z;
+        nos[y].filho[lado] = nos[x].filho[!lado];
+        if (nos[y].filho[lado] >= 0) nos[nos[y].filho[lado]].pai = y;
+        nos[x].filho[!lado] = y;
+        nos[y].pai = x;
+        atualizar(y);
+        atualizar(x);
+    }
+
+    // Splay iterativo: as inversões pendentes descem da raiz da splay até x antes
+    void splay(int x) {
+        pilha.clear();
+        for (int y = x;; y = nos[y].pai) {
+            pilha.push_back(y);
+            if (ehRaizSplay(y)) break;
+        }
+        for (auto it = pilha.rbegin(); it != pilha.rend(); ++it) empurrar(*it);
+        while (!ehRaizSplay(x)) {
+            int y = nos[x].pai;
+            if (!ehRaizSplay(y)) {
+                int z = nos[y].pai;
+                girar((nos[y].filho[0] == x) == (nos[z].filho[0] == y) ? y : x);
+            }
+            girar(x);
+        }
+    }
+
+    // Caminho preferido da raiz até x; x fica na raiz da sua splay
+    void acessar(int x) {
+        for (int ultimo = -1, y = x; y >= 0; ultimo = y, y = nos[y].pai) {
+            splay(y);
+            nos[y].filho[1] = ultimo;
+            atualizar(y);
+        }
+        splay(x);
+    }
+
+    void tornarRaiz(int x) {
+        acessar(x);
+        nos[x].inverter = !nos[x].inverter;
+    }
+
+    int raizDe(int x) {
+        acessar(x);
+        while (true) {
+            empurrar(x);
+            if (nos[x].filho[0] < 0) break;
+            x = nos[x].filho[0];
+        }
+        splay(x);
+        return x;
+    }
+
+    void ligar(int x, int y) {
+        tornarRaiz(x);
+        nos[x].pai = y;
+    }
+
+    // x e y vizinhos na árvore
+    void cortar(int x, int y) {
+        tornarRaiz(x);
+        acessar(y);
+        nos[y].filho[0] = -1;
+        nos[x].pai = -1;
+        atualizar(y);
+    }
+
+    void adicionar(const ArestaMST& a) {
+        int x;
+        if (!livres.empty()) {
+            x = livres.back();
+            livres.pop_back();
+            nos[x] = No();
+            arestaDoNo[x - numVertices] = a;
+        } else {
+            x = static_cast<int>(nos.size());
+            nos.push_back(No());
+            arestaDoNo.push_back(a);
+            ativo.push_back(0);
+        }
+        ativo[x - numVertices] = 1;
+        nos[x].maximo = x;
+        ligar(static_cast<int>(a.u), x);
+        ligar(x, static_cast<int>(a.v));
+        peso += a.peso;
+        numArestas++;
+    }
+
+    void remover(int x) {
+        ArestaMST a = aresta(x);
+        cortar(static_cast<int>(a.u), x);
+        cortar(x, static_cast<int>(a.v));
+        ativo[x - numVertices] = 0;
+        livres.push_back(x);
+        peso -= a.peso;
+        numArestas--;
+    }
+
+    void reconstruir(const std::vector<ArestaMST>& arvore) {
+        nos.assign(numVertices, No());
+        arestaDoNo.clear();
+        ativo.clear();
+        livres.clear();
+        peso = 0.0;
+        numArestas = 0;
+        for (const auto& a : arvore) adicionar(a);
+    }
+
+public:
+    // Parte da floresta de um ResultadoMST (arvoreGeradoraMinima ou Borůvka)
+    ArvoreGeradoraDinamica(int numVertices, const std::vector<ArestaMST>& arvore)
+        : numVertices(numVertices) {
+        reconstruir(arvore);
+    }
+
+    // Peso total da floresta atual, O(1). Mantido por somas e subtrações: depois de muitas
+    // trocas com pesos fracionários pode diferir da soma ordenada nos últimos dígitos.
+    double pesoTotal() const { return peso; }
+
+    std::size_t qtdArestas() const { return numArestas; }
+
+    // Insere u-v; devolve true se a floresta mudou. Laços e vértices fora do grafo são ignorados.
+    bool inserir(int u, int v, double pesoAresta) {
+        if (u == v || u < 0 || v < 0 || u >= numVertices || v >= numVertices) return false;
+        ArestaMST a = {pesoAresta + 0.0, static_cast<std::uint32_t>(std::min(u, v)),
+                       static_cast<std::uint32_t>(std::max(u, v))};
+        if (raizDe(u) != raizDe(v)) {
+            adicionar(a);
+            return true;
+        }
+        tornarRaiz(u);
+        acessar(v);
+        int maximo = nos[v].maximo;
+        if (maximo < 0 || !mst_detalhe::menor(a, aresta(maximo))) return false;
+        remover(maximo);
+        adicionar(a);
+        return true;
+    }
+
+    // Insere um lote; devolve quantas arestas entraram na floresta
+    std::size_t inserirLote(const std::vector<ArestaMST>& lote, unsigned numThreads = 0) {
+        if (lote.size() <= static_cast<std::size_t>(numVertices)) {
+            std::size_t trocas = 0;
+            for (const auto& a : lote) trocas += inserir(static_cast<int>(a.u), static_cast<int>(a.v), a.peso);
+            return trocas;
+        }
+        std::vector<ArestaMST> antes = arestas();
+        std::vector<ArestaMST> candidatas = antes;
+        for (const auto& a : lote) {
+            if (a.u == a.v || a.u >= static_cast<std::uint32_t>(numVertices) ||
+                a.v >= static_cast<std::uint32_t>(numVertices)) continue;
+            candidatas.push_back({a.peso + 0.0, std::min(a.u, a.v), std::max(a.u, a.v)});
+        }
+        ResultadoMST resultado = arvoreGeradoraMinima(numVertices, candidatas, numThreads);
+        // Entraram as que não estavam na floresta anterior
+        std::size_t mantidas = 0;
+        for (const auto& a : resultado.arestas) {
+            mantidas += std::binary_search(antes.begin(), antes.end(), a, mst_detalhe::menor);
+        }
+        reconstruir(resultado.arestas);
+        peso = resultado.pesoTotal;
+        return resultado.arestas.size() - mantidas;
+    }
+
+    // Arestas da floresta em ordem crescente de (peso, u, v), como no Kruskal
+    std::vector<ArestaMST> arestas() const {
+        std::vector<ArestaMST> lista;
+        lista.reserve(numArestas);
+        for (std::size_t i = 0; i < ativo.size(); i++) {
+            if (ativo[i]) lista.push_back(arestaDoNo[i]);
+        }
+        std::sort(lista.begin(), lista.end(), mst_detalhe::menor);
+        return lista;
+    }
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef CAMINHOS_DAG_HPP
+#define CAMINHOS_DAG_HPP
+
+// Caminhos mínimos ou máximos em DAG ponderado, em O(V + E) e sem heap: os vértices são
+// relaxados na ordem de Grafo::ordenacaoTopologica(), então quando um vértice é visitado
+// todos os arcos que chegam nele já foram relaxados. Pesos negativos não atrapalham (não
+// há ciclo para explorar), e o caminho máximo (caminho crítico) é o mesmo laço com a
+// comparação invertida.
+
+#include <vector>
+#include <limits>
+#include <chrono>
+#include <algorithm>
+#include "grafo.hpp"
+
+struct CaminhosDAG {
+    bool aciclico = false;
+    bool maisLongo = false;
+    std::vector<double> distancia;      // +inf (mínimo) ou -inf (máximo) se não alcançado
+    std::vector<int> predecessor;       // -1 nas origens e nos não alcançados
+    double segundosOrdem = 0.0;
+    double segundosRelaxacao = 0.0;
+
+    bool alcancado(int v) const {
+        return distancia[v] != (maisLongo ? -1 : 1) * std::numeric_limits<double>::infinity();
+    }
+
+    // Vértices da origem até v; vazio se v não foi alcançado
+    std::vector<int> caminhoAte(int v) const {
+        std::vector<int> caminho;
+        if (!alcancado(v)) return caminho;
+        for (int atual = v; atual != -1; atual = predecessor[atual]) caminho.push_back(atual);
+        std::reverse(caminho.begin(), caminho.end());
+        return caminho;
+    }
+};
+
+// origem = -1 parte de todos os vértices ao mesmo tempo (distância 0 em cada um): no modo
+// máximo, distancia[v] é o caminho mais pesado que termina em v.
+inline CaminhosDAG caminhosDAG(const Grafo& g, int origem, bool maisLongo = false) {
+    using relogio = std::chrono::steady_clock;
+    CaminhosDAG r;
+    r.maisLongo = maisLongo;
+    int n = g.getNumVertices();
+
+    auto t = relogio::now();
+    std::vector<int> ordem = g.ordenacaoTopologica();
+    r.segundosOrdem = std::chrono::duration<double>(relogio::now() - t).count();
+    r.aciclico = static_cast<int>(ordem.size()) == n;
+    if (!r.aciclico) return r;
+
+    t = relogio::now();
+    double infinito = std::numeric_limits<double>::infinity();
+    r.distancia.assign(n, maisLongo ? -infinito : infinito);
+    r.predecessor.assign(n, -1);
+    if (origem >= 0) {
+        r.distancia[origem] = 0.0;
+    } else {
+        std::fill(r.distancia.begin(), r.distancia.end(), 0.0);
+    }
+    for (int v : ordem) {
+        double dv = r.distancia[v];
+        if (dv == infinito || dv == -infinito) continue;
+        for (const auto& aresta : g.adjacentes(v)) {
+            double candidata = dv + aresta.peso;
+            double& atual = r.distancia[aresta.destino];
+            if (maisLongo ? candidata > atual : candidata < atual) {
+                atual = candidata;
+                r.predecessor[aresta.destino] = v;
+            }
+        }
+    }
+    r.segundosRelaxacao = std::chrono::duration<double>(relogio::now() - t).count();
+    return r;
+}
+
+#endif
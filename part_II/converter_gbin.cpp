@@ -0,0 +1,31 @@
+#include <iostream>
+#include <chrono>
+#include "grafo.hpp"
+
+using namespace std;
+
+// Converte um .net para o formato binário .gbin (CSR mapeável em memória).
+// Os programas desta parte (e da parte III) aceitam o .gbin no lugar do .net.
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "Uso: " << argv[0] << " <arquivo_grafo.net> <saida.gbin>" << endl;
+        return 1;
+    }
+    
+    string entrada = argv[1];
+    string saida = argv[2];
+    
+    auto inicio = chrono::steady_clock::now();
+    Grafo g = Grafo::lerArquivo(entrada);
+    if (!g.salvarSnapshot(saida)) {
+        cerr << "Erro ao gravar snapshot: " << saida << endl;
+        return 1;
+    }
+    auto fim = chrono::steady_clock::now();
+    
+    cout << saida << ": " << g.getNumVertices() << " vertices, "
+         << (g.ehDirigido() ? "dirigido" : "nao dirigido") << " ("
+         << chrono::duration<double, milli>(fim - inicio).count() << " ms)" << endl;
+    
+    return 0;
+}
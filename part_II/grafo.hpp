@@ -5,12 +5,14 @@
 #include <string>
 #include <map>
 #include <set>
-#include <fstream>
-#include <sstream>
 #include <algorithm>
 #include <queue>
-#include <stack>
 #include <limits>
+#include <memory>
+#include <cstdint>
+#include "leitor_pajek.hpp"
+#include "snapshot_gbin.hpp"
+#include "arvore_geradora.hpp"
 
 using namespace std;
 
@@ -21,6 +23,54 @@ struct Aresta {
     Aresta(int d, double p = 1.0) : destino(d), peso(p) {}
 };
 
+// Visão somente-leitura dos adjacentes de um vértice. Percorre o vetor do grafo
+// montado em memória ou, para um .gbin mapeado, as linhas do CSR no arquivo
+// (destinos do .gbin são os índices 1-based do .net).
+class Adjacentes {
+private:
+    const Aresta* arestas;
+    const int32_t* destinos;
+    const double* pesos;
+    size_t tamanho;
+
+public:
+    Adjacentes(const Aresta* a, size_t n) : arestas(a), destinos(nullptr), pesos(nullptr), tamanho(n) {}
+    Adjacentes(const int32_t* d, const double* p, size_t n) : arestas(nullptr), destinos(d), pesos(p), tamanho(n) {}
+    
+    Aresta operator[](size_t i) const {
+        return arestas ? arestas[i] : Aresta(destinos[i] - 1, pesos[i]);
+    }
+    
+    size_t size() const { return tamanho; }
+    bool empty() const { return tamanho == 0; }
+    
+    class iterator {
+    private:
+        const Adjacentes* adj;
+        size_t i;
+    public:
+        iterator(const Adjacentes* a, size_t pos) : adj(a), i(pos) {}
+        Aresta operator*() const { return (*adj)[i]; }
+        iterator& operator++() { i++; return *this; }
+        bool operator!=(const iterator& outro) const { return i != outro.i; }
+    };
+    
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, tamanho); }
+};
+
+// Componentes fortemente conexas em arrays planos: componente[v] é o id da componente
+// de v, e os vértices da componente c são vertices[inicio[c] .. inicio[c+1]).
+struct ComponentesFortes {
+    vector<int> componente;
+    vector<int> inicio;
+    vector<int> vertices;
+    
+    int quantidade() const {
+        return inicio.empty() ? 0 : static_cast<int>(inicio.size()) - 1;
+    }
+};
+
 class Grafo {
 private:
     int numVertices;
@@ -28,53 +78,22 @@ private:
     bool ponderado;
     vector<vector<Aresta>> listaAdj;
     vector<string> rotulos;
+    shared_ptr<const SnapshotGbin> snapshot; // .gbin mapeado (somente leitura), se houver
     
-    // Função auxiliar para DFS no algoritmo de Kosaraju
-    void dfsOrdem(int v, vector<bool>& visitado, stack<int>& pilha) {
-        visitado[v] = true;
-        
-        for (const auto& aresta : listaAdj[v]) {
-            if (!visitado[aresta.destino]) {
-                dfsOrdem(aresta.destino, visitado, pilha);
-            }
-        }
-        
-        pilha.push(v);
-    }
-    
-    // DFS para coletar componente
-    void dfsComponente(int v, vector<bool>& visitado, vector<int>& componente, 
-                       const vector<vector<Aresta>>& grafoTransposto) {
-        visitado[v] = true;
-        componente.push_back(v);
-        
-        for (const auto& aresta : grafoTransposto[v]) {
-            if (!visitado[aresta.destino]) {
-                dfsComponente(aresta.destino, visitado, componente, grafoTransposto);
+    // Copia o snapshot para listaAdj/rotulos antes de qualquer modificação
+    void materializar() {
+        if (!snapshot) return;
+        listaAdj.assign(numVertices, vector<Aresta>());
+        rotulos.assign(numVertices, string());
+        for (int v = 0; v < numVertices; v++) {
+            for (const auto& aresta : adjacentes(v)) {
+                listaAdj[v].push_back(aresta);
             }
+            rotulos[v] = snapshot->rotulo(v + 1);
         }
+        snapshot.reset();
     }
     
-    // DFS para ordenação topológica
-    bool dfsTopologica(int v, vector<int>& estado, stack<int>& pilha) {
-        estado[v] = 1; // Visitando
-        
-        for (const auto& aresta : listaAdj[v]) {
-            if (estado[aresta.destino] == 1) {
-                return false; // Ciclo detectado
-            }
-            if (estado[aresta.destino] == 0) {
-                if (!dfsTopologica(aresta.destino, estado, pilha)) {
-                    return false;
-                }
-            }
-        }
-        
-        estado[v] = 2; // Visitado
-        pilha.push(v);
-        return true;
-    }
-
 public:
     Grafo(int n, bool dir = false, bool pond = false) 
         : numVertices(n), dirigido(dir), ponderado(pond) {
@@ -83,6 +102,7 @@ public:
     }
     
     void adicionarAresta(int origem, int destino, double peso = 1.0) {
+        materializar();
         listaAdj[origem].push_back(Aresta(destino, peso));
         if (!dirigido) {
             listaAdj[destino].push_back(Aresta(origem, peso));
@@ -90,6 +110,7 @@ public:
     }
     
     void setRotulo(int vertice, const string& rotulo) {
+        materializar();
         if (vertice >= 0 && vertice < numVertices) {
             rotulos[vertice] = rotulo;
         }
@@ -97,7 +118,7 @@ public:
     
     string getRotulo(int vertice) const {
         if (vertice >= 0 && vertice < numVertices) {
-            return rotulos[vertice];
+            return snapshot ? snapshot->rotulo(vertice + 1) : rotulos[vertice];
         }
         return "";
     }
@@ -106,208 +127,261 @@ public:
         return numVertices;
     }
     
-    const vector<Aresta>& getAdjacentes(int vertice) const {
-        return listaAdj[vertice];
+    Adjacentes adjacentes(int vertice) const {
+        if (snapshot) {
+            const uint64_t* offsets = snapshot->offsets();
+            uint64_t inicio = offsets[vertice + 1];
+            return Adjacentes(snapshot->destinos() + inicio, snapshot->pesos() + inicio,
+                              offsets[vertice + 2] - inicio);
+        }
+        return Adjacentes(listaAdj[vertice].data(), listaAdj[vertice].size());
+    }
+    
+    Adjacentes getAdjacentes(int vertice) const {
+        return adjacentes(vertice);
+    }
+    
+    int grau(int vertice) const {
+        return static_cast<int>(adjacentes(vertice).size());
+    }
+    
+    bool ehDirigido() const {
+        return dirigido;
+    }
+    
+    bool ehPonderado() const {
+        return ponderado;
     }
     
-    // Algoritmo de Kosaraju para componentes fortemente conexas
-    vector<vector<int>> componentesFortementeConexas() {
-        vector<vector<int>> componentes;
-        stack<int> pilha;
-        vector<bool> visitado(numVertices, false);
+    // Componentes fortemente conexas: algoritmo de Pearce (variante do Tarjan com um só
+    // array por vértice), iterativo com pilha explícita, em uma passada e sem transposto.
+    //
+    // rindex[v] guarda a ordem de visita enquanto v está aberto e, quando a componente
+    // de v fecha, o número dela contado de n-1 para baixo; como os índices das
+    // componentes fechadas são devolvidos, os dois intervalos nunca se encontram.
+    // As componentes fecham em ordem topológica reversa; os ids finais são invertidos,
+    // então a componente 0 é uma fonte do grafo condensado (a mesma ordem do Kosaraju).
+    ComponentesFortes componentesFortementeConexas() const {
+        ComponentesFortes resultado;
+        vector<int> rindex(numVertices, 0);
+        vector<char> raiz(numVertices, 0);
+        vector<int> pilha;                        // vértices visitados, ainda sem componente
+        vector<pair<int, size_t>> chamadas;       // (vértice, próxima aresta) da DFS
+        int indice = 1;
+        int c = numVertices - 1;
         
-        // Primeira DFS para obter ordem de finalização
-        for (int i = 0; i < numVertices; i++) {
-            if (!visitado[i]) {
-                dfsOrdem(i, visitado, pilha);
+        for (int s = 0; s < numVertices; s++) {
+            if (rindex[s] != 0) continue;
+            rindex[s] = indice++;
+            raiz[s] = 1;
+            chamadas.push_back(make_pair(s, size_t(0)));
+            
+            while (!chamadas.empty()) {
+                int v = chamadas.back().first;
+                size_t& proxima = chamadas.back().second;
+                Adjacentes adj = adjacentes(v);
+                
+                if (proxima < adj.size()) {
+                    int w = adj[proxima++].destino;
+                    if (rindex[w] == 0) {
+                        rindex[w] = indice++;
+                        raiz[w] = 1;
+                        chamadas.push_back(make_pair(w, size_t(0)));
+                    } else if (rindex[w] < rindex[v]) {
+                        rindex[v] = rindex[w];
+                        raiz[v] = 0;
+                    }
+                    continue;
+                }
+                
+                // v terminou: fecha a componente se v é raiz, senão espera na pilha
+                chamadas.pop_back();
+                if (raiz[v]) {
+                    indice--;
+                    while (!pilha.empty() && rindex[v] <= rindex[pilha.back()]) {
+                        rindex[pilha.back()] = c;
+                        pilha.pop_back();
+                        indice--;
+                    }
+                    rindex[v] = c--;
+                } else {
+                    pilha.push_back(v);
+                }
+                if (!chamadas.empty()) {
+                    int pai = chamadas.back().first;
+                    if (rindex[v] < rindex[pai]) {
+                        rindex[pai] = rindex[v];
+                        raiz[pai] = 0;
+                    }
+                }
             }
         }
         
-        // Criar grafo transposto
-        vector<vector<Aresta>> grafoTransposto(numVertices);
-        for (int v = 0; v < numVertices; v++) {
-            for (const auto& aresta : listaAdj[v]) {
-                grafoTransposto[aresta.destino].push_back(Aresta(v, aresta.peso));
-            }
+        // rindex = n-1 para a primeira componente fechada; a última fechada vira a 0
+        int quantidade = numVertices - 1 - c;
+        resultado.componente = move(rindex);
+        for (int& id : resultado.componente) {
+            id = quantidade - 1 - (numVertices - 1 - id);
         }
         
-        // Segunda DFS no grafo transposto
-        fill(visitado.begin(), visitado.end(), false);
-        
-        while (!pilha.empty()) {
-            int v = pilha.top();
-            pilha.pop();
-            
-            if (!visitado[v]) {
-                vector<int> componente;
-                dfsComponente(v, visitado, componente, grafoTransposto);
-                componentes.push_back(componente);
-            }
+        // Vértices agrupados por componente (contagem), em ordem crescente dentro de cada uma
+        resultado.inicio.assign(quantidade + 1, 0);
+        for (int id : resultado.componente) resultado.inicio[id + 1]++;
+        for (int i = 0; i < quantidade; i++) resultado.inicio[i + 1] += resultado.inicio[i];
+        resultado.vertices.resize(numVertices);
+        vector<int> proximo(resultado.inicio.begin(), resultado.inicio.end() - 1);
+        for (int v = 0; v < numVertices; v++) {
+            resultado.vertices[proximo[resultado.componente[v]]++] = v;
         }
         
-        return componentes;
+        return resultado;
     }
     
-    // Ordenação topológica
-    vector<int> ordenacaoTopologica() {
+    // Ordenação topológica: pós-ordem reversa de uma DFS iterativa (pilha explícita de
+    // (vértice, próximo arco)), então caminhos longos não estouram a pilha de chamadas.
+    // Vazia se o grafo tem ciclo.
+    vector<int> ordenacaoTopologica() const {
         vector<int> ordem;
-        stack<int> pilha;
+        ordem.reserve(numVertices);
         vector<int> estado(numVertices, 0); // 0: não visitado, 1: visitando, 2: visitado
+        vector<pair<int, size_t>> chamadas;
         
         for (int i = 0; i < numVertices; i++) {
-            if (estado[i] == 0) {
-                if (!dfsTopologica(i, estado, pilha)) {
-                    return vector<int>(); // Grafo tem ciclo
+            if (estado[i] != 0) continue;
+            estado[i] = 1;
+            chamadas.push_back({i, 0});
+            while (!chamadas.empty()) {
+                int v = chamadas.back().first;
+                Adjacentes vizinhos = adjacentes(v);
+                size_t& proxima = chamadas.back().second;
+                if (proxima < vizinhos.size()) {
+                    int w = vizinhos[proxima++].destino;
+                    if (estado[w] == 1) {
+                        return vector<int>(); // Grafo tem ciclo
+                    }
+                    if (estado[w] == 0) {
+                        estado[w] = 1;
+                        chamadas.push_back({w, 0});
+                    }
+                    continue;
                 }
+                estado[v] = 2;
+                ordem.push_back(v);
+                chamadas.pop_back();
             }
         }
         
-        while (!pilha.empty()) {
-            ordem.push_back(pilha.top());
-            pilha.pop();
-        }
-        
+        reverse(ordem.begin(), ordem.end());
         return ordem;
     }
     
-    // Estrutura para Union-Find (para Kruskal)
-    class UnionFind {
-    private:
-        vector<int> pai;
-        vector<int> rank;
-        
-    public:
-        UnionFind(int n) : pai(n), rank(n, 0) {
-            for (int i = 0; i < n; i++) {
-                pai[i] = i;
-            }
-        }
-        
-        int find(int x) {
-            if (pai[x] != x) {
-                pai[x] = find(pai[x]);
-            }
-            return pai[x];
-        }
-        
-        bool unite(int x, int y) {
-            int px = find(x);
-            int py = find(y);
-            
-            if (px == py) return false;
-            
-            if (rank[px] < rank[py]) {
-                pai[px] = py;
-            } else if (rank[px] > rank[py]) {
-                pai[py] = px;
-            } else {
-                pai[py] = px;
-                rank[px]++;
-            }
-            
-            return true;
-        }
-    };
-    
-    // Algoritmo de Kruskal
-    pair<double, vector<pair<int, int>>> kruskal() {
-        vector<tuple<double, int, int>> arestas;
-        
-        // Coletar todas as arestas
+    // Arestas empacotadas para arvore_geradora.hpp
+    vector<ArestaMST> arestasMST() const {
+        vector<ArestaMST> arestas;
         for (int u = 0; u < numVertices; u++) {
-            for (const auto& aresta : listaAdj[u]) {
+            for (const auto& aresta : adjacentes(u)) {
                 if (!dirigido && u > aresta.destino) continue; // Evitar duplicatas
-                arestas.push_back(make_tuple(aresta.peso, u, aresta.destino));
+                arestas.push_back({aresta.peso, static_cast<uint32_t>(u), static_cast<uint32_t>(aresta.destino)});
             }
         }
-        
-        // Ordenar arestas por peso
-        sort(arestas.begin(), arestas.end());
-        
-        UnionFind uf(numVertices);
+        return arestas;
+    }
+    
+    // Árvore geradora mínima (Filter-Kruskal de arvore_geradora.hpp).
+    // numThreads = 0 usa todos os núcleos.
+    ResultadoMST arvoreGeradora(unsigned numThreads = 0) const {
+        vector<ArestaMST> arestas = arestasMST();
+        return arvoreGeradoraMinima(numVertices, arestas, numThreads);
+    }
+    
+    // Mesma árvore, por rodadas paralelas de Borůvka (tempos por rodada em resultado.rodadas)
+    ResultadoMST boruvka(unsigned numThreads = 0) const {
+        vector<ArestaMST> arestas = arestasMST();
+        return arvoreGeradoraBoruvka(numVertices, arestas, numThreads);
+    }
+    
+    // Algoritmo de Kruskal: peso total e arestas (u, v) em ordem crescente de peso
+    pair<double, vector<pair<int, int>>> kruskal(unsigned numThreads = 0) const {
+        ResultadoMST resultado = arvoreGeradora(numThreads);
         vector<pair<int, int>> mst;
-        double pesoTotal = 0.0;
+        for (const auto& aresta : resultado.arestas) {
+            mst.push_back(make_pair(static_cast<int>(aresta.u), static_cast<int>(aresta.v)));
+        }
+        return make_pair(resultado.pesoTotal, mst);
+    }
+    
+    // Abre um .gbin mapeado em memória: O(1), sem copiar arestas nem rótulos
+    static Grafo lerSnapshot(const string& nomeArquivo) {
+        auto snap = make_shared<const SnapshotGbin>(nomeArquivo);
+        if (!snap->valido()) {
+            cerr << "Erro: snapshot inválido: " << nomeArquivo << endl;
+            return Grafo(0);
+        }
+        Grafo g(0, snap->dirigido(), snap->ponderado());
+        g.numVertices = snap->numVertices();
+        g.snapshot = snap;
+        return g;
+    }
+    
+    // Grava o grafo como .gbin (adjacências na ordem atual, índices 1-based)
+    bool salvarSnapshot(const string& nomeArquivo) const {
+        vector<uint64_t> offsets(numVertices + 2, 0);
+        vector<int32_t> destinos;
+        vector<double> pesos;
+        vector<string> rotulosArquivo(numVertices + 1);
+        bool ordenadas = true;
         
-        for (const auto& aresta : arestas) {
-            double peso = get<0>(aresta);
-            int u = get<1>(aresta);
-            int v = get<2>(aresta);
-            
-            if (uf.unite(u, v)) {
-                mst.push_back(make_pair(u, v));
-                pesoTotal += peso;
+        for (int v = 0; v < numVertices; v++) {
+            Adjacentes adj = adjacentes(v);
+            for (size_t i = 0; i < adj.size(); i++) {
+                Aresta aresta = adj[i];
+                if (i > 0 && aresta.destino + 1 <= destinos.back()) ordenadas = false;
+                destinos.push_back(aresta.destino + 1);
+                pesos.push_back(aresta.peso);
             }
+            offsets[v + 2] = destinos.size();
+            rotulosArquivo[v + 1] = getRotulo(v);
         }
         
-        return make_pair(pesoTotal, mst);
+        uint32_t flags = (dirigido ? GBIN_DIRIGIDO : 0) | (ponderado ? GBIN_PONDERADO : 0) |
+                         (ordenadas ? GBIN_LINHAS_ORDENADAS : 0);
+        uint64_t numArestas = dirigido ? destinos.size() : destinos.size() / 2;
+        return gravarGbin(nomeArquivo, flags, numVertices, numArestas, offsets.data(),
+                          destinos.data(), pesos.data(), rotulosArquivo);
     }
     
-    // Ler grafo de arquivo
+    // Ler grafo de arquivo (.net, ou .gbin reconhecido pelo cabeçalho)
     static Grafo lerArquivo(const string& nomeArquivo) {
-        ifstream arquivo(nomeArquivo);
-        string linha;
+        if (ehArquivoGbin(nomeArquivo)) {
+            return lerSnapshot(nomeArquivo);
+        }
         
-        // Ler número de vértices
-        while (getline(arquivo, linha)) {
-            if (linha.find("*vertices") != string::npos || 
-                linha.find("*Vertices") != string::npos) {
-                stringstream ss(linha);
-                string temp;
-                int n;
-                ss >> temp >> n;
-                
-                bool dirigido = false;
-                bool ponderado = false;
-                
-                Grafo g(n, dirigido, ponderado);
-                
-                // Ler rótulos
-                for (int i = 0; i < n; i++) {
-                    getline(arquivo, linha);
-                    stringstream ss(linha);
-                    int indice;
-                    string rotulo;
-                    ss >> indice;
-                    getline(ss, rotulo);
-                    
-                    // Remover espaços iniciais
-                    size_t start = rotulo.find_first_not_of(" \t");
-                    if (start != string::npos) {
-                        rotulo = rotulo.substr(start);
-                    }
-                    
-                    g.setRotulo(indice - 1, rotulo);
-                }
-                
-                // Ler arestas
-                while (getline(arquivo, linha)) {
-                    if (linha.find("*edges") != string::npos || 
-                        linha.find("*Edges") != string::npos) {
-                        g.dirigido = false;
-                        g.ponderado = true;
-                    } else if (linha.find("*arcs") != string::npos || 
-                               linha.find("*Arcs") != string::npos) {
-                        g.dirigido = true;
-                        g.ponderado = true;
-                    } else if (!linha.empty()) {
-                        stringstream ss(linha);
-                        int u, v;
-                        double peso = 1.0;
-                        ss >> u >> v;
-                        if (ss >> peso) {
-                            g.ponderado = true;
-                        }
-                        g.adicionarAresta(u - 1, v - 1, peso);
-                    }
-                }
-                
-                arquivo.close();
-                return g;
+        ConteudoPajek conteudo = lerPajek(nomeArquivo);
+        if (!conteudo.aberto) {
+            return Grafo(0);
+        }
+        
+        int n = conteudo.numVertices;
+        Grafo g(n, false, false);
+        
+        // Rótulos
+        for (size_t i = 0; i < conteudo.indices.size(); i++) {
+            g.setRotulo(conteudo.indices[i] - 1, conteudo.rotulos[i]);
+        }
+        
+        // Arestas, seção por seção (*edges não dirigida, *arcs dirigida)
+        for (const auto& secao : conteudo.secoes) {
+            g.dirigido = secao.dirigida;
+            g.ponderado = true;
+            for (size_t i = secao.inicio; i < secao.fim; i++) {
+                int u = conteudo.origens[i] - 1;
+                int v = conteudo.destinos[i] - 1;
+                if (u < 0 || u >= n || v < 0 || v >= n) continue;
+                g.adicionarAresta(u, v, conteudo.pesos[i]);
             }
         }
         
-        arquivo.close();
-        return Grafo(0);
+        return g;
     }
 };
 
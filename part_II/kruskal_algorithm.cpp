@@ -1,33 +1,118 @@
 #include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
 #include "grafo.hpp"
+#include "arvore_dinamica.hpp"
+#include "paralelo.hpp"
 
 using namespace std;
 
+void imprimirArvore(double pesoTotal, const vector<ArestaMST>& mst) {
+    cout << fixed << setprecision(1) << pesoTotal << endl;
+    
+    for (size_t i = 0; i < mst.size(); i++) {
+        cout << (mst[i].u + 1) << "-" << (mst[i].v + 1);
+        if (i < mst.size() - 1) {
+            cout << ", ";
+        }
+    }
+    cout << endl;
+}
+
+// Modo incremental: lotes de arestas "u v peso" (1-based) chegam pela entrada padrão,
+// separados por linhas vazias. Após cada lote sai o peso total da floresta atual; no
+// fim, a floresta completa no formato do Kruskal.
+void rodarIncremental(const Grafo& g, unsigned threads) {
+    ResultadoMST inicial = g.arvoreGeradora(threads);
+    ArvoreGeradoraDinamica arvore(g.getNumVertices(), inicial.arestas);
+    vector<ArestaMST> lote;
+    size_t numLote = 0;
+    
+    auto fecharLote = [&]() {
+        if (lote.empty()) return;
+        auto inicio = chrono::steady_clock::now();
+        size_t trocas = arvore.inserirLote(lote, threads);
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        if (estatisticasAtivas()) {
+            cerr << "[incremental] lote=" << ++numLote
+                 << " arestas=" << lote.size()
+                 << " entraram=" << trocas
+                 << " tempo=" << segundos * 1000.0 << " ms" << endl;
+        }
+        cout << fixed << setprecision(1) << arvore.pesoTotal() << endl;
+        lote.clear();
+    };
+    
+    string linha;
+    while (getline(cin, linha)) {
+        istringstream campos(linha);
+        long long u, v;
+        double peso = 1.0;
+        if (!(campos >> u >> v)) {
+            fecharLote();
+            continue;
+        }
+        campos >> peso;
+        if (u < 1 || v < 1 || u > g.getNumVertices() || v > g.getNumVertices()) continue;
+        lote.push_back({peso, static_cast<uint32_t>(u - 1), static_cast<uint32_t>(v - 1)});
+    }
+    fecharLote();
+    
+    vector<ArestaMST> mst = arvore.arestas();
+    double pesoTotal = 0.0;
+    for (const auto& aresta : mst) pesoTotal += aresta.peso;
+    imprimirArvore(pesoTotal, mst);
+}
+
 int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        cerr << "Uso: " << argv[0] << " <arquivo_grafo>" << endl;
+    string modo = argc >= 3 ? argv[2] : "";
+    bool comModo = modo == "boruvka" || modo == "incremental";
+    if (argc < 2 || argc > (comModo ? 4 : 3)) {
+        cerr << "Uso: " << argv[0] << " <arquivo_grafo> [<threads>]" << endl;
+        cerr << "     " << argv[0] << " <arquivo_grafo> boruvka [<threads>]" << endl;
+        cerr << "     " << argv[0] << " <arquivo_grafo> incremental [<threads>] < lotes" << endl;
         return 1;
     }
     
     string nomeArquivo = argv[1];
+    int argThreads = comModo ? 3 : 2;
+    unsigned threads = 0;
+    if (argc > argThreads && !lerThreads(argv[argThreads], threads)) {
+        cerr << "Erro: número de threads inválido." << endl;
+        return 1;
+    }
     
     Grafo g = Grafo::lerArquivo(nomeArquivo);
     
-    // Executar ordenação topológica
-    vector<int> ordem = g.ordenacaoTopologica();
-    
-    if (ordem.empty()) {
-        cerr << "Erro: O grafo contém ciclos. Não é possível fazer ordenação topológica." << endl;
-        return 1;
+    if (modo == "incremental") {
+        rodarIncremental(g, threads);
+        return 0;
     }
     
-    for (size_t i = 0; i < ordem.size(); i++) {
-        cout << g.getRotulo(ordem[i]);
-        if (i < ordem.size() - 1) {
-            cout << " , ";
+    // Executar algoritmo de Kruskal (ou Borůvka: mesma árvore, mesma saída)
+    bool modoBoruvka = modo == "boruvka";
+    ResultadoMST resultado = modoBoruvka ? g.boruvka(threads) : g.arvoreGeradora(threads);
+    
+    if (estatisticasAtivas() && modoBoruvka) {
+        for (size_t i = 0; i < resultado.rodadas.size(); i++) {
+            cerr << "[boruvka] rodada=" << i + 1
+                 << " arestas=" << resultado.rodadas[i].arestas
+                 << " unioes=" << resultado.rodadas[i].unioes
+                 << " tempo=" << resultado.rodadas[i].segundos * 1000.0 << " ms" << endl;
         }
+        cerr << "[boruvka] rodadas=" << resultado.rodadas.size()
+             << " threads=" << resultado.threads
+             << " tempo=" << resultado.segundos * 1000.0 << " ms" << endl;
+    } else if (estatisticasAtivas()) {
+        cerr << "[kruskal] ordenadas=" << resultado.ordenadas
+             << " descartadas=" << resultado.descartadas
+             << " particoes=" << resultado.particoes
+             << " threads=" << resultado.threads
+             << " tempo=" << resultado.segundos * 1000.0 << " ms" << endl;
     }
-    cout << endl;
+    
+    imprimirArvore(resultado.pesoTotal, resultado.arestas);
     
     return 0;
 }
@@ -0,0 +1,110 @@
+#ifndef NIVEIS_TOPOLOGICOS_HPP
+#define NIVEIS_TOPOLOGICOS_HPP
+
+// Ordenação topológica por níveis (Kahn em paralelo).
+//
+// O nível 0 são os vértices sem arco de entrada; o nível k + 1, os que ficam sem arco de
+// entrada quando o nível k sai. Cada nível é uma anticadeia: os seus vértices podem rodar
+// ao mesmo tempo. A fronteira de um nível é repartida entre as threads, que decrementam
+// os graus de entrada com contadores atômicos; quem zera um grau põe o vértice no próximo
+// nível. O número de níveis é o tamanho (em vértices) do caminho crítico.
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include "grafo.hpp"
+#include "paralelo.hpp"
+
+struct NiveisTopologicos {
+    bool aciclico = false;
+    std::vector<int> vertices;          // nível a nível, cada nível em ordem crescente
+    std::vector<int> inicio;            // nível k: vertices[inicio[k] .. inicio[k + 1])
+    std::vector<int> caminhoCritico;    // um caminho com um vértice de cada nível
+    unsigned threads = 1;
+    double segundos = 0.0;
+
+    int quantidade() const {
+        return inicio.empty() ? 0 : static_cast<int>(inicio.size()) - 1;
+    }
+};
+
+// numThreads = 0 usa todos os núcleos. Com ciclo, aciclico = false e os níveis param nos
+// vértices que não dependem de nenhum ciclo.
+inline NiveisTopologicos niveisTopologicos(const Grafo& g, unsigned numThreads = 0) {
+    auto comeco = std::chrono::steady_clock::now();
+    NiveisTopologicos r;
+    r.threads = threadsEfetivas(numThreads);
+    unsigned threads = r.threads;
+    int n = g.getNumVertices();
+
+    std::unique_ptr<std::atomic<int>[]> grau(new std::atomic<int>[n]);
+    for (int v = 0; v < n; v++) grau[v].store(0, std::memory_order_relaxed);
+    emFaixas(n, threads, [&](int inicio, int fim) {
+        for (int v = inicio; v < fim; v++) {
+            for (const auto& aresta : g.adjacentes(v)) grau[aresta.destino].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+
+    r.vertices.reserve(n);
+    for (int v = 0; v < n; v++) {
+        if (grau[v].load(std::memory_order_relaxed) == 0) r.vertices.push_back(v);
+    }
+    r.inicio.push_back(0);
+    std::vector<std::vector<int>> proximos(threads);
+    while (static_cast<int>(r.vertices.size()) > r.inicio.back()) {
+        int base = r.inicio.back();
+        int tamanho = static_cast<int>(r.vertices.size()) - base;
+        r.inicio.push_back(static_cast<int>(r.vertices.size()));
+        unsigned usadas = tamanho < 1024 ? 1 : threads;
+        emParalelo(usadas, [&](unsigned id) {
+            int inicio = base + static_cast<int>(static_cast<std::int64_t>(tamanho) * id / usadas);
+            int fim = base + static_cast<int>(static_cast<std::int64_t>(tamanho) * (id + 1) / usadas);
+            for (int i = inicio; i < fim; i++) {
+                for (const auto& aresta : g.adjacentes(r.vertices[i])) {
+                    // acq_rel: quem zera vê os decrementos das outras threads
+                    if (grau[aresta.destino].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        proximos[id].push_back(aresta.destino);
+                    }
+                }
+            }
+        });
+        for (auto& p : proximos) {
+            r.vertices.insert(r.vertices.end(), p.begin(), p.end());
+            p.clear();
+        }
+        std::sort(r.vertices.begin() + r.inicio.back(), r.vertices.end());
+    }
+    r.aciclico = static_cast<int>(r.vertices.size()) == n;
+
+    // Caminho crítico de trás para frente: o menor vértice do último nível e, a cada passo,
+    // o menor do nível anterior com arco para o atual (sempre existe um)
+    int niveis = r.quantidade();
+    if (r.aciclico && niveis > 0) {
+        int atual = r.vertices[r.inicio[niveis - 1]];
+        r.caminhoCritico.push_back(atual);
+        for (int k = niveis - 2; k >= 0; k--) {
+            for (int i = r.inicio[k]; i < r.inicio[k + 1]; i++) {
+                int v = r.vertices[i];
+                bool liga = false;
+                for (const auto& aresta : g.adjacentes(v)) {
+                    if (aresta.destino == atual) {
+                        liga = true;
+                        break;
+                    }
+                }
+                if (liga) {
+                    atual = v;
+                    break;
+                }
+            }
+            r.caminhoCritico.push_back(atual);
+        }
+        std::reverse(r.caminhoCritico.begin(), r.caminhoCritico.end());
+    }
+    r.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - comeco).count();
+    return r;
+}
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef ORDEM_DINAMICA_HPP
+#define ORDEM_DINAMICA_HPP
+
+// Ordem topológica mantida sob inserções de arcos (Pearce-Kelly).
+//
+// posicao[v] é o lugar de v na ordem e vertice[i] o inverso. Inserir u -> v com
+// posicao[u] < posicao[v] não muda nada. Senão, só a região afetada [posicao[v], posicao[u]]
+// é olhada:
+//   - busca para frente a partir de v, só por vértices com posição <= posicao[u]: se
+//     chegar a u, o arco fecha um ciclo e é recusado (a ordem fica como estava);
+//   - busca para trás a partir de u, só por vértices com posição >= posicao[v];
+//   - os achados para trás passam a ocupar as primeiras das posições envolvidas, os
+//     achados para frente as seguintes, cada grupo mantendo a ordem relativa.
+// O custo depende só dos vértices e arcos dessa região, não do grafo todo.
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "grafo.hpp"
+
+class OrdemTopologicaDinamica {
+private:
+    int numVertices;
+    std::vector<std::vector<int>> saida;
+    std::vector<std::vector<int>> entrada;
+    std::vector<int> posicao;
+    std::vector<int> vertice;
+
+    std::vector<char> visitado;
+    std::vector<int> pilha;
+    std::vector<int> frente;
+    std::vector<int> tras;
+    std::vector<int> posicoes;
+    std::uint64_t movidos = 0;
+
+    // Marca em conjunto os alcançados de inicio pelas listas dadas, dentro da janela de
+    // posições [minimo, maximo]; devolve false se passar por proibido
+    bool buscar(int inicio, const std::vector<std::vector<int>>& listas, int minimo, int maximo,
+                int proibido, std::vector<int>& conjunto) {
+        visitado[inicio] = 1;
+        conjunto.push_back(inicio);
+        pilha.assign(1, inicio);
+        while (!pilha.empty()) {
+            int x = pilha.back();
+            pilha.pop_back();
+            for (int w : listas[x]) {
+                if (w == proibido) return false;
+                if (visitado[w] || posicao[w] < minimo || posicao[w] > maximo) continue;
+                visitado[w] = 1;
+                conjunto.push_back(w);
+                pilha.push_back(w);
+            }
+        }
+        return true;
+    }
+
+    void reordenar() {
+        auto porPosicao = [&](int a, int b) { return posicao[a] < posicao[b]; };
+        std::sort(tras.begin(), tras.end(), porPosicao);
+        std::sort(frente.begin(), frente.end(), porPosicao);
+        posicoes.clear();
+        for (int x : tras) posicoes.push_back(posicao[x]);
+        for (int x : frente) posicoes.push_back(posicao[x]);
+        std::sort(posicoes.begin(), posicoes.end());
+        std::size_t i = 0;
+        for (int x : tras) posicao[x] = posicoes[i++];
+        for (int x : frente) posicao[x] = posicoes[i++];
+        for (int x : tras) vertice[posicao[x]] = x;
+        for (int x : frente) vertice[posicao[x]] = x;
+        movidos += posicoes.size();
+    }
+
+    void limparMarcas() {
+        for (int x : frente) visitado[x] = 0;
+        for (int x : tras) visitado[x] = 0;
+        frente.clear();
+        tras.clear();
+    }
+
+public:
+    explicit OrdemTopologicaDinamica(int numVertices)
+        : numVertices(numVertices), saida(numVertices), entrada(numVertices),
+          posicao(numVertices), vertice(numVertices), visitado(numVertices, 0) {
+        for (int v = 0; v < numVertices; v++) posicao[v] = vertice[v] = v;
+    }
+
+    // Parte dos arcos do grafo. Sem ciclo, a ordem inicial sai de uma vez (Kahn); com
+    // ciclo, os arcos entram um a um e os que fecham ciclo vão para recusados (u, v).
+    OrdemTopologicaDinamica(const Grafo& g, std::vector<std::pair<int, int>>& recusados)
+        : OrdemTopologicaDinamica(g.getNumVertices()) {
+        std::vector<int> grau(numVertices, 0);
+        for (int u = 0; u < numVertices; u++) {
+            for (const auto& aresta : g.adjacentes(u)) grau[aresta.destino]++;
+        }
+        std::vector<int> ordem;
+        for (int v = 0; v < numVertices; v++) {
+            if (grau[v] == 0) ordem.push_back(v);
+        }
+        for (std::size_t i = 0; i < ordem.size(); i++) {
+            for (const auto& aresta : g.adjacentes(ordem[i])) {
+                if (--grau[aresta.destino] == 0) ordem.push_back(aresta.destino);
+            }
+        }
+        bool semCiclo = static_cast<int>(ordem.size()) == numVertices;
+        if (semCiclo) {
+            for (int i = 0; i < numVertices; i++) {
+                vertice[i] = ordem[i];
+                posicao[ordem[i]] = i;
+            }
+        }
+        for (int u = 0; u < numVertices; u++) {
+            for (const auto& aresta : g.adjacentes(u)) {
+                if (semCiclo) {
+                    saida[u].push_back(aresta.destino);
+                    entrada[aresta.destino].push_back(u);
+                } else if (!inserir(u, aresta.destino)) {
+                    recusados.push_back({u, aresta.destino});
+                }
+            }
+        }
+    }
+
+    // Insere u -> v; devolve false (e não insere) se o arco fecharia um ciclo
+    bool inserir(int u, int v) {
+        if (u == v) return false;
+        int minimo = posicao[v];
+        int maximo = posicao[u];
+        if (minimo > maximo) {
+            saida[u].push_back(v);
+            entrada[v].push_back(u);
+            return true;
+        }
+        bool aciclico = buscar(v, saida, minimo, maximo, u, frente);
+        if (aciclico) {
+            buscar(u, entrada, minimo, maximo, -1, tras);
+            reordenar();
+            saida[u].push_back(v);
+            entrada[v].push_back(u);
+        }
+        limparMarcas();
+        return aciclico;
+    }
+
+    // Vértices na ordem topológica atual
+    const std::vector<int>& ordem() const { return vertice; }
+
+    int posicaoDe(int v) const { return posicao[v]; }
+
+    // Total de posições reatribuídas desde a construção (tamanho das regiões afetadas)
+    std::uint64_t verticesMovidos() const { return movidos; }
+};
+
+#endif
@@ -0,0 +1,127 @@
+#ifndef PARALELO_HPP
+#define PARALELO_HPP
+
+// Peças comuns aos algoritmos multithread das partes I, II e III: leitura do número de
+// threads, barreira reutilizável, execução em faixas e divisão de blocos com roubo de
+// trabalho.
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <string>
+#include <charconv>
+#include <cstdint>
+#include <algorithm>
+
+// Número de threads: 0 = todos os núcleos disponíveis
+inline unsigned threadsEfetivas(unsigned pedidas) {
+    return pedidas > 0 ? pedidas : std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Pedidos acima disso são tratados como erro de digitação, não como threads de verdade
+const unsigned LIMITE_THREADS = 1024;
+
+// Número inteiro ocupando o texto inteiro; false se não for número ou não couber em T
+template <typename T>
+bool lerNumero(const std::string& texto, T& valor) {
+    const char* fim = texto.data() + texto.size();
+    auto lido = std::from_chars(texto.data(), fim, valor);
+    return lido.ec == std::errc() && lido.ptr == fim;
+}
+
+// Número de threads da linha de comando: 1..LIMITE_THREADS (sem o argumento, usa-se 0)
+inline bool lerThreads(const std::string& texto, unsigned& threads) {
+    unsigned valor = 0;
+    if (!lerNumero(texto, valor) || valor == 0 || valor > LIMITE_THREADS) return false;
+    threads = valor;
+    return true;
+}
+
+// Barreira reutilizável para um número fixo de threads
+class Barreira {
+private:
+    std::mutex trava;
+    std::condition_variable condicao;
+    unsigned total;
+    unsigned esperando = 0;
+    unsigned geracao = 0;
+
+public:
+    explicit Barreira(unsigned total) : total(total) {}
+
+    void esperar() {
+        std::unique_lock<std::mutex> bloqueio(trava);
+        unsigned minha = geracao;
+        if (++esperando == total) {
+            esperando = 0;
+            geracao++;
+            condicao.notify_all();
+        } else {
+            condicao.wait(bloqueio, [&] { return geracao != minha; });
+        }
+    }
+};
+
+// Executa f(inicio, fim) em `threads` faixas contíguas de [0, n)
+template <typename F>
+void emFaixas(int n, unsigned threads, F f) {
+    if (threads <= 1 || n < 1024) {
+        f(0, n);
+        return;
+    }
+    std::vector<std::thread> trabalhadores;
+    for (unsigned t = 0; t < threads; t++) {
+        int inicio = static_cast<int>(static_cast<std::int64_t>(n) * t / threads);
+        int fim = static_cast<int>(static_cast<std::int64_t>(n) * (t + 1) / threads);
+        trabalhadores.emplace_back(f, inicio, fim);
+    }
+    for (auto& t : trabalhadores) t.join();
+}
+
+// Roda trabalhar(id) em `threads` threads (a chamadora é a de id 0)
+template <typename F>
+void emParalelo(unsigned threads, F trabalhar) {
+    std::vector<std::thread> trabalhadores;
+    for (unsigned t = 1; t < threads; t++) trabalhadores.emplace_back(trabalhar, t);
+    trabalhar(0u);
+    for (auto& t : trabalhadores) t.join();
+}
+
+// Blocos 0..numBlocos-1 repartidos em faixas, uma por thread. Cada thread consome a
+// sua faixa pela frente; ao esgotá-la, rouba blocos das faixas das outras. Dona e
+// ladras avançam a faixa com fetch_add, então nunca pegam o mesmo bloco.
+class DivisaoTrabalho {
+private:
+    struct alignas(64) Faixa {
+        std::atomic<std::size_t> proximo{0};
+        std::size_t fim = 0;
+    };
+    unsigned threads;
+    std::unique_ptr<Faixa[]> faixas;
+
+public:
+    explicit DivisaoTrabalho(unsigned threads) : threads(threads), faixas(new Faixa[threads]) {}
+
+    // Chamado por uma thread só, antes da barreira que libera o trabalho
+    void preparar(std::size_t numBlocos) {
+        for (unsigned t = 0; t < threads; t++) {
+            faixas[t].proximo.store(numBlocos * t / threads, std::memory_order_relaxed);
+            faixas[t].fim = numBlocos * (t + 1) / threads;
+        }
+    }
+
+    bool pegar(unsigned id, std::size_t& bloco) {
+        for (unsigned k = 0; k < threads; k++) {
+            Faixa& f = faixas[(id + k) % threads];
+            if (f.proximo.load(std::memory_order_relaxed) >= f.fim) continue;
+            bloco = f.proximo.fetch_add(1, std::memory_order_relaxed);
+            if (bloco < f.fim) return true;
+        }
+        return false;
+    }
+};
+
+#endif
@@ -0,0 +1,360 @@
+#ifndef SCC_PARALELO_HPP
+#define SCC_PARALELO_HPP
+
+// Componentes fortemente conexas em paralelo, em três fases (como no Multistep):
+//
+//   1. poda: vértices sem arco de entrada ou de saída entre os ativos são componentes
+//      sozinhos; a remoção baixa os graus dos vizinhos, em rodadas com contadores atômicos;
+//   2. forward-backward: do pivô de maior grau(entrada) * grau(saída), uma BFS paralela
+//      pelos arcos e outra pelos arcos reversos; a interseção é a componente do pivô,
+//      em geral a gigante;
+//   3. coloração: cada vértice ativo propaga o maior id que o alcança (máximo atômico)
+//      até estabilizar; um vértice que ficou com a própria cor é raiz, e a busca reversa
+//      a partir dele, só por vértices da mesma cor, é a sua componente. As raízes são
+//      resolvidas em paralelo e a fase se repete sobre o que sobrou.
+//
+// Quando restam poucos vértices, ou uma passada resolve menos de 10% dos ativos (cadeias
+// longas de componentes pequenas, a cauda longa), o Pearce sequencial termina o trabalho.
+
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include "grafo.hpp"
+#include "paralelo.hpp"
+
+// Abaixo disso os ativos restantes vão para o Pearce sequencial
+const int SCC_LIMIAR_SEQUENCIAL = 1 << 16;
+
+struct ResultadoSCCParalelo {
+    ComponentesFortes componentes;     // ids em ordem do menor vértice de cada componente
+    unsigned threads = 1;
+    int aparados = 0;                  // componentes unitárias achadas pela poda
+    int gigante = 0;                   // tamanho da componente do pivô
+    int passadasColoracao = 0;         // repetições da coloração sobre os ativos restantes
+    int componentesColoracao = 0;
+    int sequenciais = 0;               // vértices que sobraram para o Pearce
+    double segundosCSR = 0.0;
+    double segundosPoda = 0.0;
+    double segundosForwardBackward = 0.0;
+    double segundosColoracao = 0.0;
+    double segundosSequencial = 0.0;
+};
+
+namespace scc_detalhe {
+
+struct LinhasCSR {
+    std::vector<std::uint64_t> offsets;
+    std::vector<int> destinos;
+};
+
+// Todos os ativos alcançáveis de fonte pelas linhas dadas recebem o bit em marca
+inline void alcancar(int fonte, const LinhasCSR& linhas, const std::vector<int>& componente,
+                     std::atomic<std::uint8_t>* marca, std::uint8_t bit, unsigned threads) {
+    std::vector<int> fronteira = {fonte};
+    marca[fonte].fetch_or(bit, std::memory_order_relaxed);
+    std::vector<std::vector<int>> proximas(threads);
+    while (!fronteira.empty()) {
+        std::size_t n = fronteira.size();
+        unsigned usadas = n < 1024 ? 1 : threads;
+        emParalelo(usadas, [&](unsigned id) {
+            for (std::size_t i = n * id / usadas; i < n * (id + 1) / usadas; i++) {
+                int v = fronteira[i];
+                for (std::uint64_t p = linhas.offsets[v]; p < linhas.offsets[v + 1]; p++) {
+                    int w = linhas.destinos[p];
+                    if (componente[w] != -1 || (marca[w].load(std::memory_order_relaxed) & bit)) continue;
+                    if (!(marca[w].fetch_or(bit, std::memory_order_relaxed) & bit)) proximas[id].push_back(w);
+                }
+            }
+        });
+        fronteira.clear();
+        for (auto& p : proximas) {
+            fronteira.insert(fronteira.end(), p.begin(), p.end());
+            p.clear();
+        }
+    }
+}
+
+// Pearce iterativo restrito aos vértices com componente == -1; ids a partir de proximoId
+inline void pearceRestrito(int n, const LinhasCSR& saida, std::vector<int>& componente, int& proximoId) {
+    std::vector<int> rindex(n, 0);
+    std::vector<char> raiz(n, 0);
+    std::vector<int> pilha;
+    std::vector<std::pair<int, std::uint64_t>> chamadas;
+    int indice = 1;
+    int c = n - 1;
+    for (int s = 0; s < n; s++) {
+        if (componente[s] != -1 || rindex[s] != 0) continue;
+        rindex[s] = indice++;
+        raiz[s] = 1;
+        chamadas.push_back({s, saida.offsets[s]});
+        while (!chamadas.empty()) {
+            int v = chamadas.back().first;
+            std::uint64_t& proxima = chamadas.back().second;
+            if (proxima < saida.offsets[v + 1]) {
+                int w = saida.destinos[proxima++];
+                if (componente[w] != -1) continue;
+                if (rindex[w] == 0) {
+                    rindex[w] = indice++;
+                    raiz[w] = 1;
+                    chamadas.push_back({w, saida.offsets[w]});
+                } else if (rindex[w] < rindex[v]) {
+                    rindex[v] = rindex[w];
+                    raiz[v] = 0;
+                }
+                continue;
+            }
+            chamadas.pop_back();
+            if (raiz[v]) {
+                indice--;
+                while (!pilha.empty() && rindex[v] <= rindex[pilha.back()]) {
+                    rindex[pilha.back()] = c;
+                    pilha.pop_back();
+                    indice--;
+                }
+                rindex[v] = c--;
+            } else {
+                pilha.push_back(v);
+            }
+            if (!chamadas.empty() && rindex[v] < rindex[chamadas.back().first]) {
+                rindex[chamadas.back().first] = rindex[v];
+                raiz[chamadas.back().first] = 0;
+            }
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        if (componente[v] == -1 && rindex[v] != 0) componente[v] = proximoId + (n - 1 - rindex[v]);
+    }
+    proximoId += n - 1 - c;
+}
+
+} // namespace scc_detalhe
+
+// Mesmas componentes de Grafo::componentesFortementeConexas(), numeradas pela ordem do
+// menor vértice de cada uma. numThreads = 0 usa todos os núcleos; limiarSequencial menor
+// que o padrão força a coloração em grafos pequenos (o teste usa 0).
+inline ResultadoSCCParalelo componentesFortesParalelo(const Grafo& g, unsigned numThreads = 0,
+                                                      int limiarSequencial = SCC_LIMIAR_SEQUENCIAL) {
+    using relogio = std::chrono::steady_clock;
+    using scc_detalhe::LinhasCSR;
+    auto segundosDesde = [](relogio::time_point t) {
+        return std::chrono::duration<double>(relogio::now() - t).count();
+    };
+    ResultadoSCCParalelo r;
+    r.threads = threadsEfetivas(numThreads);
+    unsigned threads = r.threads;
+    int n = g.getNumVertices();
+
+    // Arcos e arcos reversos em CSR (laços ficam de fora: não mudam componente nenhuma)
+    auto t = relogio::now();
+    LinhasCSR saida, entrada;
+    saida.offsets.assign(n + 1, 0);
+    entrada.offsets.assign(n + 1, 0);
+    for (int v = 0; v < n; v++) {
+        for (const auto& aresta : g.adjacentes(v)) {
+            if (aresta.destino == v) continue;
+            saida.offsets[v + 1]++;
+            entrada.offsets[aresta.destino + 1]++;
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        saida.offsets[v + 1] += saida.offsets[v];
+        entrada.offsets[v + 1] += entrada.offsets[v];
+    }
+    saida.destinos.resize(saida.offsets[n]);
+    entrada.destinos.resize(entrada.offsets[n]);
+    std::vector<std::uint64_t> proximo(entrada.offsets.begin(), entrada.offsets.end() - 1);
+    emFaixas(n, threads, [&](int inicio, int fim) {
+        for (int v = inicio; v < fim; v++) {
+            std::uint64_t p = saida.offsets[v];
+            for (const auto& aresta : g.adjacentes(v)) {
+                if (aresta.destino != v) saida.destinos[p++] = aresta.destino;
+            }
+        }
+    });
+    for (int v = 0; v < n; v++) {
+        for (std::uint64_t p = saida.offsets[v]; p < saida.offsets[v + 1]; p++) {
+            entrada.destinos[proximo[saida.destinos[p]]++] = v;
+        }
+    }
+    r.segundosCSR = segundosDesde(t);
+
+    std::vector<int> componente(n, -1);
+    std::atomic<int> proximoId{0};
+
+    // 1. Poda
+    t = relogio::now();
+    std::unique_ptr<std::atomic<int>[]> grauEntrada(new std::atomic<int>[n]);
+    std::unique_ptr<std::atomic<int>[]> grauSaida(new std::atomic<int>[n]);
+    std::unique_ptr<std::atomic<char>[]> aparado(new std::atomic<char>[n]);
+    std::vector<int> fronteira;
+    for (int v = 0; v < n; v++) {
+        grauEntrada[v].store(static_cast<int>(entrada.offsets[v + 1] - entrada.offsets[v]), std::memory_order_relaxed);
+        grauSaida[v].store(static_cast<int>(saida.offsets[v + 1] - saida.offsets[v]), std::memory_order_relaxed);
+        bool trivial = grauEntrada[v].load(std::memory_order_relaxed) == 0 || grauSaida[v].load(std::memory_order_relaxed) == 0;
+        aparado[v].store(trivial, std::memory_order_relaxed);
+        if (trivial) fronteira.push_back(v);
+    }
+    std::vector<std::vector<int>> proximas(threads);
+    while (!fronteira.empty()) {
+        std::size_t tamanho = fronteira.size();
+        unsigned usadas = tamanho < 1024 ? 1 : threads;
+        emParalelo(usadas, [&](unsigned id) {
+            auto soltar = [&](int w, std::atomic<int>* grau) {
+                if (grau[w].fetch_sub(1, std::memory_order_relaxed) == 1 &&
+                    !aparado[w].exchange(1, std::memory_order_relaxed)) {
+                    proximas[id].push_back(w);
+                }
+            };
+            for (std::size_t i = tamanho * id / usadas; i < tamanho * (id + 1) / usadas; i++) {
+                int v = fronteira[i];
+                componente[v] = proximoId.fetch_add(1, std::memory_order_relaxed);
+                for (std::uint64_t p = saida.offsets[v]; p < saida.offsets[v + 1]; p++) soltar(saida.destinos[p], grauEntrada.get());
+                for (std::uint64_t p = entrada.offsets[v]; p < entrada.offsets[v + 1]; p++) soltar(entrada.destinos[p], grauSaida.get());
+            }
+        });
+        r.aparados += static_cast<int>(tamanho);
+        fronteira.clear();
+        for (auto& p : proximas) {
+            fronteira.insert(fronteira.end(), p.begin(), p.end());
+            p.clear();
+        }
+    }
+    r.segundosPoda = segundosDesde(t);
+
+    // 2. Forward-backward a partir do pivô
+    t = relogio::now();
+    int pivo = -1;
+    std::int64_t melhor = -1;
+    for (int v = 0; v < n; v++) {
+        if (componente[v] != -1) continue;
+        std::int64_t produto = static_cast<std::int64_t>(grauEntrada[v].load(std::memory_order_relaxed)) *
+                               grauSaida[v].load(std::memory_order_relaxed);
+        if (produto > melhor) {
+            melhor = produto;
+            pivo = v;
+        }
+    }
+    if (pivo >= 0) {
+        std::unique_ptr<std::atomic<std::uint8_t>[]> marca(new std::atomic<std::uint8_t>[n]);
+        for (int v = 0; v < n; v++) marca[v].store(0, std::memory_order_relaxed);
+        scc_detalhe::alcancar(pivo, saida, componente, marca.get(), 1, threads);
+        scc_detalhe::alcancar(pivo, entrada, componente, marca.get(), 2, threads);
+        int idGigante = proximoId.fetch_add(1, std::memory_order_relaxed);
+        for (int v = 0; v < n; v++) {
+            if (marca[v].load(std::memory_order_relaxed) == 3) {
+                componente[v] = idGigante;
+                r.gigante++;
+            }
+        }
+    }
+    r.segundosForwardBackward = segundosDesde(t);
+
+    // 3. Coloração, enquanto sobrarem muitos ativos
+    t = relogio::now();
+    std::unique_ptr<std::atomic<int>[]> cor(new std::atomic<int>[n]);
+    std::unique_ptr<std::atomic<char>[]> naFila(new std::atomic<char>[n]);
+    std::vector<int> ativos;
+    for (int v = 0; v < n; v++) {
+        if (componente[v] == -1) ativos.push_back(v);
+    }
+    while (static_cast<int>(ativos.size()) > limiarSequencial) {
+        r.passadasColoracao++;
+        for (int v : ativos) {
+            cor[v].store(v, std::memory_order_relaxed);
+            naFila[v].store(0, std::memory_order_relaxed);
+        }
+        // Propagação assíncrona: cada thread parte dos seus ativos em ordem decrescente de
+        // id, só dos que ainda têm a própria cor, e segue em profundidade; quem muda de cor
+        // entra na pilha de quem mudou. Em uma thread cada vértice é colorido uma vez só
+        // (o primeiro a alcançá-lo já é o maior).
+        unsigned usadas = ativos.size() < 1024 ? 1 : threads;
+        emParalelo(usadas, [&](unsigned id) {
+            std::vector<int>& pilha = proximas[id];
+            for (std::size_t i = ativos.size(); i-- > 0;) {
+                if (i % usadas != id || cor[ativos[i]].load(std::memory_order_seq_cst) != ativos[i]) continue;
+                pilha.push_back(ativos[i]);
+                while (!pilha.empty()) {
+                    int v = pilha.back();
+                    pilha.pop_back();
+                    // Limpa antes de ler a cor: um aumento depois disso põe v de volta numa pilha
+                    naFila[v].store(0, std::memory_order_seq_cst);
+                    int c = cor[v].load(std::memory_order_seq_cst);
+                    for (std::uint64_t p = saida.offsets[v]; p < saida.offsets[v + 1]; p++) {
+                        int w = saida.destinos[p];
+                        if (componente[w] != -1) continue;
+                        int atual = cor[w].load(std::memory_order_relaxed);
+                        while (c > atual && !cor[w].compare_exchange_weak(atual, c, std::memory_order_seq_cst)) {
+                        }
+                        if (c > atual && !naFila[w].exchange(1, std::memory_order_seq_cst)) pilha.push_back(w);
+                    }
+                }
+            }
+        });
+
+        // Cada raiz fecha a sua componente pelos arcos reversos, só dentro da sua cor
+        std::vector<int> raizes;
+        for (int v : ativos) {
+            if (cor[v].load(std::memory_order_relaxed) == v) raizes.push_back(v);
+        }
+        DivisaoTrabalho trabalho(threads);
+        trabalho.preparar(raizes.size());
+        emParalelo(threads, [&](unsigned id) {
+            std::vector<int> pilha;
+            std::size_t b;
+            while (trabalho.pegar(id, b)) {
+                int raiz = raizes[b];
+                int idComponente = proximoId.fetch_add(1, std::memory_order_relaxed);
+                componente[raiz] = idComponente;
+                pilha.push_back(raiz);
+                while (!pilha.empty()) {
+                    int v = pilha.back();
+                    pilha.pop_back();
+                    for (std::uint64_t p = entrada.offsets[v]; p < entrada.offsets[v + 1]; p++) {
+                        int w = entrada.destinos[p];
+                        // A cor antes: vértices de outra cor são de outra thread
+                        if (cor[w].load(std::memory_order_relaxed) != raiz || componente[w] != -1) continue;
+                        componente[w] = idComponente;
+                        pilha.push_back(w);
+                    }
+                }
+            }
+        });
+        r.componentesColoracao += static_cast<int>(raizes.size());
+
+        std::size_t antes = ativos.size();
+        ativos.erase(std::remove_if(ativos.begin(), ativos.end(), [&](int v) { return componente[v] != -1; }),
+                     ativos.end());
+        if ((antes - ativos.size()) * 10 < antes) break;
+    }
+    r.segundosColoracao = segundosDesde(t);
+
+    // Cauda: Pearce nos ativos restantes
+    t = relogio::now();
+    r.sequenciais = static_cast<int>(ativos.size());
+    int id = proximoId.load();
+    if (!ativos.empty()) scc_detalhe::pearceRestrito(n, saida, componente, id);
+    r.segundosSequencial = segundosDesde(t);
+
+    // Ids renumerados pelo menor vértice; vértices agrupados em ordem crescente
+    ComponentesFortes& resultado = r.componentes;
+    std::vector<int> novoId(id, -1);
+    int quantidade = 0;
+    for (int v = 0; v < n; v++) {
+        int& novo = novoId[componente[v]];
+        if (novo == -1) novo = quantidade++;
+        componente[v] = novo;
+    }
+    resultado.inicio.assign(quantidade + 1, 0);
+    for (int c : componente) resultado.inicio[c + 1]++;
+    for (int c = 0; c < quantidade; c++) resultado.inicio[c + 1] += resultado.inicio[c];
+    resultado.vertices.resize(n);
+    std::vector<int> posicao(resultado.inicio.begin(), resultado.inicio.end() - 1);
+    for (int v = 0; v < n; v++) resultado.vertices[posicao[componente[v]]++] = v;
+    resultado.componente = std::move(componente);
+    return r;
+}
+
+#endif
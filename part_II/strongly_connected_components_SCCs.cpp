@@ -1,31 +1,112 @@
 #include <iostream>
-#include <algorithm>
+#include <string>
+#include <cstring>
+#include <cctype>
+#include <charconv>
+#include <iterator>
+#include <chrono>
 #include "grafo.hpp"
+#include "scc_paralelo.hpp"
+#include "alcance.hpp"
+#include "paralelo.hpp"
 
 using namespace std;
 
+// Modo alcance: pares "u v" (1-based) pela entrada padrão, uma resposta "sim"/"nao" por
+// par, nessa ordem. Vértices fora do grafo respondem "nao".
+void responderAlcance(const Grafo& g, unsigned threads) {
+    IndiceAlcance indice(g, g.componentesFortementeConexas(), threads);
+    auto inicio = chrono::steady_clock::now();
+    
+    // Entrada inteira de uma vez e números com from_chars: com milhões de pares, ler e
+    // escrever linha a linha pelos streams custaria muito mais que as consultas
+    string entrada{istreambuf_iterator<char>(cin), istreambuf_iterator<char>()};
+    string saida;
+    size_t consultas = 0;
+    const char* p = entrada.data();
+    const char* fimEntrada = p + entrada.size();
+    while (p < fimEntrada) {
+        const char* fimLinha = static_cast<const char*>(memchr(p, '\n', fimEntrada - p));
+        if (!fimLinha) fimLinha = fimEntrada;
+        long long u = 0, v = 0;
+        while (p < fimLinha && isspace(static_cast<unsigned char>(*p))) p++;
+        auto lido = from_chars(p, fimLinha, u);
+        p = lido.ptr;
+        while (p < fimLinha && isspace(static_cast<unsigned char>(*p))) p++;
+        auto lido2 = from_chars(p, fimLinha, v);
+        p = fimLinha + 1;
+        if (lido.ec != errc() || lido2.ec != errc()) continue;
+        bool valido = u >= 1 && v >= 1 && u <= g.getNumVertices() && v <= g.getNumVertices();
+        saida += valido && indice.alcanca(static_cast<int>(u - 1), static_cast<int>(v - 1)) ? "sim\n" : "nao\n";
+        consultas++;
+    }
+    cout << saida;
+    if (estatisticasAtivas()) {
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        cerr << "[alcance] componentes=" << indice.condensacao().quantidade()
+             << " arcos=" << indice.condensacao().destinos.size()
+             << " indice=" << (indice.fechoEmBitset() ? "bitset" : "intervalos")
+             << " bytes=" << indice.bytes()
+             << " construcao=" << indice.segundosConstrucao() * 1000.0 << " ms" << endl;
+        cerr << "[alcance] consultas=" << consultas
+             << " tempo=" << segundos * 1000.0 << " ms" << endl;
+    }
+}
+
 int main(int argc, char* argv[]) {
-    if (argc < 2) {
+    string modo = argc >= 3 ? argv[2] : "";
+    bool modoParalelo = modo == "paralelo";
+    if (argc < 2 || argc > 4 || (argc >= 3 && !modoParalelo && modo != "alcance")) {
         cerr << "Uso: " << argv[0] << " <arquivo_grafo>" << endl;
+        cerr << "     " << argv[0] << " <arquivo_grafo> paralelo [<threads>]" << endl;
+        cerr << "     " << argv[0] << " <arquivo_grafo> alcance [<threads>] < pares" << endl;
         return 1;
     }
     
     string nomeArquivo = argv[1];
+    unsigned threads = 0;
+    if (argc == 4 && !lerThreads(argv[3], threads)) {
+        cerr << "Erro: número de threads inválido." << endl;
+        return 1;
+    }
     Grafo g = Grafo::lerArquivo(nomeArquivo);
+    
+    if (modo == "alcance") {
+        responderAlcance(g, threads);
+        return 0;
+    }
 
-    vector<vector<int>> componentes = g.componentesFortementeConexas();
+    // Paralelo: mesmas componentes, listadas pela ordem do menor vértice de cada uma
+    ComponentesFortes componentes;
+    if (modoParalelo) {
+        ResultadoSCCParalelo resultado = componentesFortesParalelo(g, threads);
+        if (estatisticasAtivas()) {
+            cerr << "[scc] threads=" << resultado.threads
+                 << " csr=" << resultado.segundosCSR * 1000.0 << " ms" << endl;
+            cerr << "[scc] poda: componentes=" << resultado.aparados
+                 << " tempo=" << resultado.segundosPoda * 1000.0 << " ms" << endl;
+            cerr << "[scc] forward-backward: gigante=" << resultado.gigante
+                 << " tempo=" << resultado.segundosForwardBackward * 1000.0 << " ms" << endl;
+            cerr << "[scc] coloracao: componentes=" << resultado.componentesColoracao
+                 << " passadas=" << resultado.passadasColoracao
+                 << " tempo=" << resultado.segundosColoracao * 1000.0 << " ms" << endl;
+            cerr << "[scc] sequencial: vertices=" << resultado.sequenciais
+                 << " tempo=" << resultado.segundosSequencial * 1000.0 << " ms" << endl;
+        }
+        componentes = move(resultado.componentes);
+    } else {
+        componentes = g.componentesFortementeConexas();
+    }
     
-    for (const auto& componente : componentes) {
-        vector<int> comp = componente;
-        sort(comp.begin(), comp.end());
-        
-        for (size_t i = 0; i < comp.size(); i++) {
-            cout << (comp[i] + 1);
-            if (i < comp.size() - 1) {
+    // Uma linha por componente, vértices já em ordem crescente
+    for (int c = 0; c < componentes.quantidade(); c++) {
+        for (int i = componentes.inicio[c]; i < componentes.inicio[c + 1]; i++) {
+            cout << (componentes.vertices[i] + 1);
+            if (i < componentes.inicio[c + 1] - 1) {
                 cout << ",";
             }
         }
-        cout << endl;
+        cout << '\n';
     }
     
     return 0;
@@ -0,0 +1,91 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include "grafo.hpp"
+#include "scc_paralelo.hpp"
+
+using namespace std;
+
+// Confere componentesFortesParalelo() contra o Pearce sequencial em grafos aleatórios:
+// mesma partição (cada vértice com o mesmo menor vértice da sua componente), com 1 a 8
+// threads, com o limiar padrão e com limiar 0 (coloração até o fim, mesmo em grafo pequeno).
+
+// Para cada vértice, o menor vértice da sua componente: não depende da numeração dos ids
+vector<int> representantes(const ComponentesFortes& c, int n) {
+    vector<int> menor(c.quantidade(), n);
+    for (int v = 0; v < n; v++) menor[c.componente[v]] = min(menor[c.componente[v]], v);
+    vector<int> r(n);
+    for (int v = 0; v < n; v++) r[v] = menor[c.componente[v]];
+    return r;
+}
+
+// Três formas: arcos uniformes; ciclos curtos encadeados, alguns fundidos por arcos curtos de volta
+// (cauda longa de componentes pequenas, que a poda não tira e vai para a coloração); e uma
+// componente gigante com árvores penduradas
+Grafo grafoAleatorio(mt19937& gerador, int forma) {
+    int n = uniform_int_distribution<int>(1000, 6000)(gerador);
+    Grafo g(n, true);
+    uniform_int_distribution<int> vertice(0, n - 1);
+    if (forma == 0) {
+        int m = n * uniform_int_distribution<int>(1, 4)(gerador);
+        for (int i = 0; i < m; i++) g.adicionarAresta(vertice(gerador), vertice(gerador));
+    } else if (forma == 1) {
+        int v = 0;
+        while (v < n) {
+            int tamanho = min(n - v, uniform_int_distribution<int>(2, 8)(gerador));
+            for (int i = 0; i < tamanho; i++) g.adicionarAresta(v + i, v + (i + 1) % tamanho);
+            if (v + tamanho < n) g.adicionarAresta(v, v + tamanho);
+            v += tamanho;
+        }
+        for (int i = 0; i < n / 50; i++) {
+            int a = vertice(gerador);
+            g.adicionarAresta(a, max(0, a - uniform_int_distribution<int>(1, 20)(gerador)));
+        }
+    } else {
+        int gigante = n / 2;
+        for (int v = 0; v < gigante; v++) g.adicionarAresta(v, (v + 1) % gigante);
+        for (int i = 0; i < gigante; i++) {
+            g.adicionarAresta(uniform_int_distribution<int>(0, gigante - 1)(gerador),
+                              uniform_int_distribution<int>(0, gigante - 1)(gerador));
+        }
+        for (int v = gigante; v < n; v++) {
+            int pai = uniform_int_distribution<int>(0, v - 1)(gerador);
+            if (gerador() % 2) {
+                g.adicionarAresta(pai, v);
+            } else {
+                g.adicionarAresta(v, pai);
+            }
+        }
+        g.adicionarAresta(vertice(gerador), vertice(gerador));
+    }
+    return g;
+}
+
+int main(int argc, char* argv[]) {
+    int quantidade = 60;
+    if (argc == 2 && (!lerNumero(argv[1], quantidade) || quantidade < 1)) {
+        cerr << "Uso: " << argv[0] << " [<grafos>]" << endl;
+        return 1;
+    }
+
+    mt19937 gerador(2024);
+    int falhas = 0;
+    for (int i = 0; i < quantidade; i++) {
+        Grafo g = grafoAleatorio(gerador, i % 3);
+        int n = g.getNumVertices();
+        vector<int> esperado = representantes(g.componentesFortementeConexas(), n);
+        for (unsigned threads : {1u, 2u, 4u, 8u}) {
+            for (int limiar : {0, SCC_LIMIAR_SEQUENCIAL}) {
+                auto r = componentesFortesParalelo(g, threads, limiar);
+                if (representantes(r.componentes, n) != esperado) {
+                    cerr << "Falha: grafo " << i << " (forma " << i % 3 << ", n=" << n << ")"
+                         << " threads=" << threads << " limiar=" << limiar << endl;
+                    falhas++;
+                }
+            }
+        }
+    }
+    if (falhas > 0) return 1;
+    cout << "scc paralelo: " << quantidade << " grafos iguais ao sequencial" << endl;
+    return 0;
+}
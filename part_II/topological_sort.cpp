@@ -1,12 +1,149 @@
 #include <iostream>
-#include <iomanip>
+#include <sstream>
+#include <chrono>
 #include "grafo.hpp"
+#include "ordem_dinamica.hpp"
+#include "niveis_topologicos.hpp"
+#include "caminhos_dag.hpp"
+#include "paralelo.hpp"
 
 using namespace std;
 
+void imprimirOrdem(const Grafo& g, const vector<int>& ordem) {
+    for (size_t i = 0; i < ordem.size(); i++) {
+        cout << g.getRotulo(ordem[i]);
+        if (i < ordem.size() - 1) {
+            cout << " , ";
+        }
+    }
+    cout << endl;
+}
+
+// Modo incremental: arcos "u v" (1-based) chegam pela entrada padrão, um por linha, e a
+// ordem é mantida a cada um. Cada arco que fecharia um ciclo (do grafo ou da entrada) é
+// recusado e sai como "ciclo: u -> v"; no fim, a ordem com os arcos aceitos.
+void rodarIncremental(const Grafo& g) {
+    auto reportar = [&](int u, int v) {
+        cout << "ciclo: " << g.getRotulo(u) << " -> " << g.getRotulo(v) << '\n';
+    };
+    vector<pair<int, int>> recusados;
+    OrdemTopologicaDinamica ordem(g, recusados);
+    for (const auto& arco : recusados) reportar(arco.first, arco.second);
+    
+    auto inicio = chrono::steady_clock::now();
+    size_t inseridos = 0, ciclos = 0;
+    string linha;
+    while (getline(cin, linha)) {
+        istringstream campos(linha);
+        long long u, v;
+        if (!(campos >> u >> v)) continue;
+        if (u < 1 || v < 1 || u > g.getNumVertices() || v > g.getNumVertices()) continue;
+        inseridos++;
+        if (!ordem.inserir(static_cast<int>(u - 1), static_cast<int>(v - 1))) {
+            reportar(static_cast<int>(u - 1), static_cast<int>(v - 1));
+            ciclos++;
+        }
+    }
+    if (estatisticasAtivas()) {
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        cerr << "[incremental] recusados_no_grafo=" << recusados.size()
+             << " arcos=" << inseridos
+             << " ciclos=" << ciclos
+             << " movidos=" << ordem.verticesMovidos()
+             << " tempo=" << segundos * 1000.0 << " ms" << endl;
+    }
+    imprimirOrdem(g, ordem.ordem());
+}
+
+// Modo níveis: uma linha por nível (vértices que podem rodar juntos) e o caminho crítico
+int imprimirNiveis(const Grafo& g, unsigned threads) {
+    NiveisTopologicos niveis = niveisTopologicos(g, threads);
+    if (estatisticasAtivas()) {
+        cerr << "[niveis] niveis=" << niveis.quantidade()
+             << " threads=" << niveis.threads
+             << " tempo=" << niveis.segundos * 1000.0 << " ms" << endl;
+    }
+    if (!niveis.aciclico) {
+        cerr << "Erro: O grafo contém ciclos. Não é possível fazer ordenação topológica." << endl;
+        return 1;
+    }
+    
+    for (int k = 0; k < niveis.quantidade(); k++) {
+        vector<int> nivel(niveis.vertices.begin() + niveis.inicio[k], niveis.vertices.begin() + niveis.inicio[k + 1]);
+        imprimirOrdem(g, nivel);
+    }
+    cout << "Caminho crítico: " << niveis.caminhoCritico.size() << " vértices" << endl;
+    for (size_t i = 0; i < niveis.caminhoCritico.size(); i++) {
+        cout << g.getRotulo(niveis.caminhoCritico[i]);
+        if (i < niveis.caminhoCritico.size() - 1) {
+            cout << " -> ";
+        }
+    }
+    cout << endl;
+    return 0;
+}
+
+// Modo caminhos: distância e caminho da origem (ou de qualquer vértice, com "todos") até
+// cada vértice, no formato do Dijkstra da parte I; com "maximo", também o caminho crítico
+int imprimirCaminhos(const Grafo& g, const string& argOrigem, bool maisLongo) {
+    int origem = -1;
+    if (argOrigem != "todos") {
+        if (!lerNumero(argOrigem, origem) || origem < 1 || origem > g.getNumVertices()) {
+            cerr << "Erro: vértice de origem inválido." << endl;
+            return 1;
+        }
+        origem--;
+    }
+    CaminhosDAG caminhos = caminhosDAG(g, origem, maisLongo);
+    if (estatisticasAtivas()) {
+        cerr << "[caminhos] ordem=" << caminhos.segundosOrdem * 1000.0 << " ms"
+             << " relaxacao=" << caminhos.segundosRelaxacao * 1000.0 << " ms" << endl;
+    }
+    if (!caminhos.aciclico) {
+        cerr << "Erro: O grafo contém ciclos. Não é possível fazer ordenação topológica." << endl;
+        return 1;
+    }
+    
+    auto imprimir = [&](int v) {
+        // Não alcançado: "v: v; d=inf", como no Dijkstra da parte I
+        vector<int> caminho = caminhos.alcancado(v) ? caminhos.caminhoAte(v) : vector<int>{v};
+        for (size_t i = 0; i < caminho.size(); i++) {
+            if (i > 0) cout << ",";
+            cout << g.getRotulo(caminho[i]);
+        }
+        cout << "; d=";
+        if (caminhos.alcancado(v)) {
+            cout << caminhos.distancia[v];
+        } else {
+            cout << (maisLongo ? "-inf" : "inf");
+        }
+        cout << '\n';
+    };
+    int fimCritico = -1;
+    for (int v = 0; v < g.getNumVertices(); v++) {
+        cout << g.getRotulo(v) << ": ";
+        imprimir(v);
+        if (caminhos.alcancado(v) && (fimCritico == -1 || caminhos.distancia[v] > caminhos.distancia[fimCritico])) {
+            fimCritico = v;
+        }
+    }
+    if (maisLongo && fimCritico != -1) {
+        cout << "Caminho crítico: ";
+        imprimir(fimCritico);
+    }
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
-    if (argc < 2) {
+    string modo = argc >= 3 ? argv[2] : "";
+    bool modoIncremental = argc == 3 && modo == "incremental";
+    bool modoNiveis = (argc == 3 || argc == 4) && modo == "niveis";
+    bool modoCaminhos = (argc == 4 || (argc == 5 && string(argv[4]) == "maximo")) && modo == "caminhos";
+    if (argc < 2 || argc > 5 || (argc >= 3 && !modoIncremental && !modoNiveis && !modoCaminhos)) {
         cerr << "Uso: " << argv[0] << " <arquivo_grafo>" << endl;
+        cerr << "     " << argv[0] << " <arquivo_grafo> niveis [<threads>]" << endl;
+        cerr << "     " << argv[0] << " <arquivo_grafo> caminhos <origem|todos> [maximo]" << endl;
+        cerr << "     " << argv[0] << " <arquivo_grafo> incremental < arcos" << endl;
         return 1;
     }
     
@@ -14,20 +151,31 @@ int main(int argc, char* argv[]) {
     
     Grafo g = Grafo::lerArquivo(nomeArquivo);
     
-    // Executar algoritmo de Kruskal
-    pair<double, vector<pair<int, int>>> resultado = g.kruskal();
-    double pesoTotal = resultado.first;
-    vector<pair<int, int>> mst = resultado.second;
+    if (modoIncremental) {
+        rodarIncremental(g);
+        return 0;
+    }
+    if (modoNiveis) {
+        unsigned threads = 0;
+        if (argc == 4 && !lerThreads(argv[3], threads)) {
+            cerr << "Erro: número de threads inválido." << endl;
+            return 1;
+        }
+        return imprimirNiveis(g, threads);
+    }
+    if (modoCaminhos) {
+        return imprimirCaminhos(g, argv[3], argc == 5);
+    }
     
-    cout << fixed << setprecision(1) << pesoTotal << endl;
+    // Executar ordenação topológica
+    vector<int> ordem = g.ordenacaoTopologica();
     
-    for (size_t i = 0; i < mst.size(); i++) {
-        cout << (mst[i].first + 1) << "-" << (mst[i].second + 1);
-        if (i < mst.size() - 1) {
-            cout << ", ";
-        }
+    if (ordem.empty()) {
+        cerr << "Erro: O grafo contém ciclos. Não é possível fazer ordenação topológica." << endl;
+        return 1;
     }
-    cout << endl;
+    
+    imprimirOrdem(g, ordem);
     
     return 0;
 }
@@ -1,24 +1,67 @@
 #include <iostream>
 #include <iomanip>
 #include "grafo.hpp"
+#include "paralelo.hpp"
 
 using namespace std;
 
 int main(int argc, char* argv[]) {
-    if (argc < 4) {
+    string modo = argc >= 5 ? argv[4] : "dinic";
+    bool modoParalelo = modo == "push-relabel-paralelo";
+    if (argc < 4 || argc > (modoParalelo ? 6 : 5) || (modo != "dinic" && modo != "push-relabel" && !modoParalelo)) {
         cerr << "Usage: " << argv[0] << " <graph_file> <source> <sink>" << endl;
+        cerr << "       " << argv[0] << " <graph_file> <source> <sink> push-relabel" << endl;
+        cerr << "       " << argv[0] << " <graph_file> <source> <sink> push-relabel-paralelo [<threads>]" << endl;
         return 1;
     }
     
     string nomeArquivo = argv[1];
-    int s = stoi(argv[2]) - 1; // Converter para índice 0
-    int t = stoi(argv[3]) - 1;
+    int s = 0;
+    int t = 0;
+    if (!lerNumero(argv[2], s) || !lerNumero(argv[3], t)) {
+        cerr << "Error: invalid source or sink." << endl;
+        return 1;
+    }
+    unsigned threads = 0;
+    if (argc == 6 && !lerThreads(argv[5], threads)) {
+        cerr << "Error: invalid thread count." << endl;
+        return 1;
+    }
     
     // Ler grafo do arquivo
     Grafo g = Grafo::lerArquivo(nomeArquivo);
+    if (s < 1 || s > g.getNumVertices() || t < 1 || t > g.getNumVertices()) {
+        cerr << "Error: source and sink must be vertices 1.." << g.getNumVertices() << "." << endl;
+        return 1;
+    }
+    s--; // Converter para índice 0
+    t--;
     
-    // Executar algoritmo de Edmonds-Karp
-    double fluxoMaximo = g.edmondsKarp(s, t);
+    // Fluxo máximo (Dinic sobre a rede residual esparsa, ou push-relabel; mesmo valor)
+    ResultadoFluxo resultado;
+    if (modo == "dinic") {
+        resultado = g.dinic(s, t);
+    } else if (modoParalelo) {
+        resultado = g.pushRelabelParalelo(s, t, threads);
+    } else {
+        resultado = g.pushRelabel(s, t);
+    }
+    double fluxoMaximo = resultado.valor;
+    if (estatisticasAtivas() && modo == "dinic") {
+        cerr << "[fluxo] fases=" << resultado.fases
+             << " aumentos=" << resultado.aumentos
+             << " tempo=" << resultado.segundos * 1000.0 << " ms" << endl;
+    } else if (estatisticasAtivas()) {
+        double segundos = max(resultado.segundos, 1e-9);
+        cerr << "[push-relabel] threads=" << resultado.threads
+             << " empurroes=" << resultado.empurroes
+             << " (" << resultado.empurroes / segundos << "/s)"
+             << " reetiquetagens=" << resultado.reetiquetagens
+             << " (" << resultado.reetiquetagens / segundos << "/s)"
+             << " globais=" << resultado.reetiquetagensGlobais;
+        if (modoParalelo) cerr << " rodadas=" << resultado.rodadas;
+        cerr << " tempo=" << resultado.segundos * 1000.0 << " ms" << endl;
+    }
     
     // Imprimir resultado (sem casas decimais se for inteiro)
     if (fluxoMaximo == (int)fluxoMaximo) {
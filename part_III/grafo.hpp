@@ -5,14 +5,17 @@
 #include <string>
 #include <map>
 #include <set>
-#include <fstream>
-#include <sstream>
 #include <algorithm>
 #include <queue>
 #include <stack>
 #include <limits>
 #include <climits>
 #include <cmath>
+#include <memory>
+#include <cstdint>
+#include "leitor_pajek.hpp"
+#include "snapshot_gbin.hpp"
+#include "rede_residual.hpp"
 
 using namespace std;
 
@@ -24,6 +27,42 @@ struct Aresta {
     Aresta(int d, double p = 1.0) : destino(d), peso(p), fluxo(0.0) {}
 };
 
+// Visão somente-leitura dos adjacentes de um vértice. Percorre o vetor do grafo
+// montado em memória ou, para um .gbin mapeado, as linhas do CSR no arquivo
+// (destinos do .gbin são os índices 1-based do .net).
+class Adjacentes {
+private:
+    const Aresta* arestas;
+    const int32_t* destinos;
+    const double* pesos;
+    size_t tamanho;
+
+public:
+    Adjacentes(const Aresta* a, size_t n) : arestas(a), destinos(nullptr), pesos(nullptr), tamanho(n) {}
+    Adjacentes(const int32_t* d, const double* p, size_t n) : arestas(nullptr), destinos(d), pesos(p), tamanho(n) {}
+    
+    Aresta operator[](size_t i) const {
+        return arestas ? arestas[i] : Aresta(destinos[i] - 1, pesos[i]);
+    }
+    
+    size_t size() const { return tamanho; }
+    bool empty() const { return tamanho == 0; }
+    
+    class iterator {
+    private:
+        const Adjacentes* adj;
+        size_t i;
+    public:
+        iterator(const Adjacentes* a, size_t pos) : adj(a), i(pos) {}
+        Aresta operator*() const { return (*adj)[i]; }
+        iterator& operator++() { i++; return *this; }
+        bool operator!=(const iterator& outro) const { return i != outro.i; }
+    };
+    
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, tamanho); }
+};
+
 class Grafo {
 private:
     int numVertices;
@@ -31,34 +70,22 @@ private:
     bool ponderado;
     vector<vector<Aresta>> listaAdj;
     vector<string> rotulos;
+    shared_ptr<const SnapshotGbin> snapshot; // .gbin mapeado (somente leitura), se houver
     
-    // BFS para Edmonds-Karp
-    bool bfs(int s, int t, vector<int>& pai, const vector<vector<double>>& capacidadeResidual) {
-        vector<bool> visitado(numVertices, false);
-        queue<int> fila;
-        fila.push(s);
-        visitado[s] = true;
-        pai[s] = -1;
-        
-        while (!fila.empty()) {
-            int u = fila.front();
-            fila.pop();
-            
-            for (int v = 0; v < numVertices; v++) {
-                if (!visitado[v] && capacidadeResidual[u][v] > 0) {
-                    fila.push(v);
-                    pai[v] = u;
-                    visitado[v] = true;
-                    if (v == t) return true;
-                }
+    // Copia o snapshot para listaAdj/rotulos antes de qualquer modificação
+    void materializar() {
+        if (!snapshot) return;
+        listaAdj.assign(numVertices, vector<Aresta>());
+        rotulos.assign(numVertices, string());
+        for (int v = 0; v < numVertices; v++) {
+            for (const auto& aresta : adjacentes(v)) {
+                listaAdj[v].push_back(aresta);
             }
+            rotulos[v] = snapshot->rotulo(v + 1);
         }
-        
-        return false;
+        snapshot.reset();
     }
     
-
-
 public:
     Grafo(int n, bool dir = false, bool pond = false) 
         : numVertices(n), dirigido(dir), ponderado(pond) {
@@ -67,6 +94,7 @@ public:
     }
     
     void adicionarAresta(int origem, int destino, double peso = 1.0) {
+        materializar();
         listaAdj[origem].push_back(Aresta(destino, peso));
         if (!dirigido) {
             listaAdj[destino].push_back(Aresta(origem, peso));
@@ -74,6 +102,7 @@ public:
     }
     
     void setRotulo(int vertice, const string& rotulo) {
+        materializar();
         if (vertice >= 0 && vertice < numVertices) {
             rotulos[vertice] = rotulo;
         }
@@ -81,7 +110,7 @@ public:
     
     string getRotulo(int vertice) const {
         if (vertice >= 0 && vertice < numVertices) {
-            return rotulos[vertice];
+            return snapshot ? snapshot->rotulo(vertice + 1) : rotulos[vertice];
         }
         return "";
     }
@@ -90,50 +119,69 @@ public:
         return numVertices;
     }
     
-    const vector<Aresta>& getAdjacentes(int vertice) const {
-        return listaAdj[vertice];
+    Adjacentes adjacentes(int vertice) const {
+        if (snapshot) {
+            const uint64_t* offsets = snapshot->offsets();
+            uint64_t inicio = offsets[vertice + 1];
+            return Adjacentes(snapshot->destinos() + inicio, snapshot->pesos() + inicio,
+                              offsets[vertice + 2] - inicio);
+        }
+        return Adjacentes(listaAdj[vertice].data(), listaAdj[vertice].size());
     }
     
-    // Algoritmo de Edmonds-Karp (Ford-Fulkerson com BFS)
-    double edmondsKarp(int s, int t) {
-        vector<vector<double>> capacidadeResidual(numVertices, vector<double>(numVertices, 0.0));
-        
-        // Construir grafo residual inicial
+    Adjacentes getAdjacentes(int vertice) const {
+        return adjacentes(vertice);
+    }
+    
+    int grau(int vertice) const {
+        return static_cast<int>(adjacentes(vertice).size());
+    }
+    
+    bool ehDirigido() const {
+        return dirigido;
+    }
+    
+    bool ehPonderado() const {
+        return ponderado;
+    }
+    
+    // Rede residual esparsa (rede_residual.hpp): um arco residual por aresta e um reverso.
+    // Em grafo não-dirigido cada sentido é um arco com a capacidade da aresta.
+    RedeResidual redeResidual() const {
+        vector<ArcoCapacidade> arcos;
         for (int u = 0; u < numVertices; u++) {
-            for (const auto& aresta : listaAdj[u]) {
-                capacidadeResidual[u][aresta.destino] += aresta.peso;
+            for (const auto& aresta : adjacentes(u)) {
+                arcos.push_back({u, aresta.destino, aresta.peso});
             }
         }
-        
-        vector<int> pai(numVertices);
-        double fluxoMaximo = 0;
-        
-        // Enquanto existir caminho aumentante
-        while (bfs(s, t, pai, capacidadeResidual)) {
-            // Encontrar capacidade mínima no caminho
-            double fluxoCaminho = numeric_limits<double>::max();
-            for (int v = t; v != s; v = pai[v]) {
-                int u = pai[v];
-                fluxoCaminho = min(fluxoCaminho, capacidadeResidual[u][v]);
-            }
-            
-            // Atualizar capacidades residuais
-            for (int v = t; v != s; v = pai[v]) {
-                int u = pai[v];
-                capacidadeResidual[u][v] -= fluxoCaminho;
-                capacidadeResidual[v][u] += fluxoCaminho;
-            }
-            
-            fluxoMaximo += fluxoCaminho;
-        }
-        
-        return fluxoMaximo;
+        return RedeResidual(numVertices, arcos);
+    }
+    
+    // Fluxo máximo com fases, aumentos e tempo
+    ResultadoFluxo dinic(int s, int t) const {
+        return redeResidual().dinic(s, t);
+    }
+    
+    // Mesmo valor de fluxo máximo por push-relabel (rede_residual.hpp), sequencial ou sem
+    // travas em várias threads (numThreads = 0 usa todos os núcleos)
+    ResultadoFluxo pushRelabel(int s, int t) const {
+        return redeResidual().pushRelabel(s, t);
+    }
+    
+    ResultadoFluxo pushRelabelParalelo(int s, int t, unsigned numThreads = 0) const {
+        return redeResidual().pushRelabelParalelo(s, t, numThreads);
+    }
+    
+    // Fluxo máximo de s para t. Mantém o nome e a interface do Edmonds-Karp com matriz,
+    // mas roda Dinic sobre a rede residual esparsa: memória O(V + E) em vez de O(V^2).
+    double edmondsKarp(int s, int t) const {
+        return dinic(s, t).valor;
     }
     
     // DFS para encontrar caminho aumentante
     bool dfsAumentante(int u, vector<bool>& visitado, vector<int>& matchU, 
                        vector<int>& matchV, int n1) {
-        for (const auto& aresta : listaAdj[u]) {
+        for (const auto& aresta : adjacentes(u)) {
             int v = aresta.destino;
             
             // v deve estar na segunda partição
@@ -207,7 +255,7 @@ public:
             // Verificar se é conjunto independente
             for (size_t i = 0; i < vertices.size() && ehIndependente; i++) {
                 for (size_t j = i + 1; j < vertices.size() && ehIndependente; j++) {
-                    for (const auto& aresta : listaAdj[vertices[i]]) {
+                    for (const auto& aresta : adjacentes(vertices[i])) {
                         if (aresta.destino == vertices[j]) {
                             ehIndependente = false;
                             break;
@@ -224,7 +272,7 @@ public:
         // Usar algoritmo guloso melhorado (Welsh-Powell)
         vector<pair<int, int>> graus;
         for (int i = 0; i < n; i++) {
-            graus.push_back(make_pair(listaAdj[i].size(), i));
+            graus.push_back(make_pair(grau(i), i));
         }
         sort(graus.rbegin(), graus.rend());
         
@@ -234,7 +282,7 @@ public:
             int v = p.second;
             
             set<int> coresVizinhas;
-            for (const auto& aresta : listaAdj[v]) {
+            for (const auto& aresta : adjacentes(v)) {
                 if (cor[aresta.destino] != -1) {
                     coresVizinhas.insert(cor[aresta.destino]);
                 }
@@ -252,70 +300,78 @@ public:
         return make_pair(numCores, cor);
     }
     
-    // Ler grafo de arquivo
+    // Abre um .gbin mapeado em memória: O(1), sem copiar arestas nem rótulos
+    static Grafo lerSnapshot(const string& nomeArquivo) {
+        auto snap = make_shared<const SnapshotGbin>(nomeArquivo);
+        if (!snap->valido()) {
+            cerr << "Erro: snapshot inválido: " << nomeArquivo << endl;
+            return Grafo(0);
+        }
+        Grafo g(0, snap->dirigido(), snap->ponderado());
+        g.numVertices = snap->numVertices();
+        g.snapshot = snap;
+        return g;
+    }
+    
+    // Grava o grafo como .gbin (adjacências na ordem atual, índices 1-based)
+    bool salvarSnapshot(const string& nomeArquivo) const {
+        vector<uint64_t> offsets(numVertices + 2, 0);
+        vector<int32_t> destinos;
+        vector<double> pesos;
+        vector<string> rotulosArquivo(numVertices + 1);
+        bool ordenadas = true;
+        
+        for (int v = 0; v < numVertices; v++) {
+            Adjacentes adj = adjacentes(v);
+            for (size_t i = 0; i < adj.size(); i++) {
+                Aresta aresta = adj[i];
+                if (i > 0 && aresta.destino + 1 <= destinos.back()) ordenadas = false;
+                destinos.push_back(aresta.destino + 1);
+                pesos.push_back(aresta.peso);
+            }
+            offsets[v + 2] = destinos.size();
+            rotulosArquivo[v + 1] = getRotulo(v);
+        }
+        
+        uint32_t flags = (dirigido ? GBIN_DIRIGIDO : 0) | (ponderado ? GBIN_PONDERADO : 0) |
+                         (ordenadas ? GBIN_LINHAS_ORDENADAS : 0);
+        uint64_t numArestas = dirigido ? destinos.size() : destinos.size() / 2;
+        return gravarGbin(nomeArquivo, flags, numVertices, numArestas, offsets.data(),
+                          destinos.data(), pesos.data(), rotulosArquivo);
+    }
+    
+    // Ler grafo de arquivo (.net, ou .gbin reconhecido pelo cabeçalho)
     static Grafo lerArquivo(const string& nomeArquivo) {
-        ifstream arquivo(nomeArquivo);
-        string linha;
+        if (ehArquivoGbin(nomeArquivo)) {
+            return lerSnapshot(nomeArquivo);
+        }
         
-        while (getline(arquivo, linha)) {
-            if (linha.find("*vertices") != string::npos || 
-                linha.find("*Vertices") != string::npos) {
-                stringstream ss(linha);
-                string temp;
-                int n;
-                ss >> temp >> n;
-                
-                bool dirigido = false;
-                bool ponderado = false;
-                
-                Grafo g(n, dirigido, ponderado);
-                
-                // Ler rótulos
-                for (int i = 0; i < n; i++) {
-                    getline(arquivo, linha);
-                    stringstream ss(linha);
-                    int indice;
-                    string rotulo;
-                    ss >> indice;
-                    getline(ss, rotulo);
-                    
-                    size_t start = rotulo.find_first_not_of(" \t");
-                    if (start != string::npos) {
-                        rotulo = rotulo.substr(start);
-                    }
-                    
-                    g.setRotulo(indice - 1, rotulo);
-                }
-                
-                // Ler arestas
-                while (getline(arquivo, linha)) {
-                    if (linha.find("*edges") != string::npos || 
-                        linha.find("*Edges") != string::npos) {
-                        g.dirigido = false;
-                        g.ponderado = true;
-                    } else if (linha.find("*arcs") != string::npos || 
-                               linha.find("*Arcs") != string::npos) {
-                        g.dirigido = true;
-                        g.ponderado = true;
-                    } else if (!linha.empty()) {
-                        stringstream ss(linha);
-                        int u, v;
-                        double peso = 1.0;
-                        ss >> u >> v;
-                        if (ss >> peso) {
-                            g.ponderado = true;
-                        }
-                        g.adicionarAresta(u - 1, v - 1, peso);
-                    }
-                }
-                
-                arquivo.close();
-                return g;
+        ConteudoPajek conteudo = lerPajek(nomeArquivo);
+        if (!conteudo.aberto) {
+            return Grafo(0);
+        }
+        
+        int n = conteudo.numVertices;
+        Grafo g(n, false, false);
+        
+        // Rótulos
+        for (size_t i = 0; i < conteudo.indices.size(); i++) {
+            g.setRotulo(conteudo.indices[i] - 1, conteudo.rotulos[i]);
+        }
+        
+        // Arestas, seção por seção (*edges não dirigida, *arcs dirigida)
+        for (const auto& secao : conteudo.secoes) {
+            g.dirigido = secao.dirigida;
+            g.ponderado = true;
+            for (size_t i = secao.inicio; i < secao.fim; i++) {
+                int u = conteudo.origens[i] - 1;
+                int v = conteudo.destinos[i] - 1;
+                if (u < 0 || u >= n || v < 0 || v >= n) continue;
+                g.adicionarAresta(u, v, conteudo.pesos[i]);
             }
         }
         
-        arquivo.close();
-        return Grafo(0);
+        return g;
     }
 };
 
@@ -0,0 +1,465 @@
+#ifndef REDE_RESIDUAL_HPP
+#define REDE_RESIDUAL_HPP
+
+// Rede residual esparsa e fluxo máximo de Dinic.
+//
+// Cada arco u -> v de capacidade c vira dois arcos residuais em CSR: u -> v com c e
+// v -> u com 0, cada um com o índice do outro em reverso[]. Empurrar f por e é
+// residual[e] -= f e residual[reverso[e]] += f. A memória é O(V + E), em vez da matriz
+// V x V do Edmonds-Karp anterior.
+//
+// Dinic, por fases: uma BFS a partir de s dá os níveis do grafo residual; depois, um
+// fluxo bloqueante só por arcos de nível i para i + 1, com DFS iterativa e ponteiro de
+// arco atual por vértice (um arco que não leva a t nunca é olhado de novo na fase, e um
+// vértice sem saída é cortado do nível). São no máximo V fases, O(V^2 E) no total.
+//
+// Push-relabel (pré-fluxo), só a primeira fase: o valor do fluxo máximo é o excesso que
+// chega a t quando nenhum vértice de altura < V tem excesso.
+//   - sequencial: maior altura primeiro, FIFO entre os de mesma altura, ponteiro de arco
+//     atual; reetiquetagem global (BFS reversa a partir de t, alturas exatas) no início e a
+//     cada FLUXO_ALFA * V + E de trabalho de reetiquetagem; gap: quando a última altura h
+//     esvazia, todos acima de h ficam sem caminho para t e saem (altura V);
+//   - paralelo (Hong): rodadas sobre os vértices ativos, cada um com uma thread só. Um
+//     vértice empurra para o vizinho residual mais baixo se está acima dele, senão sobe
+//     para um acima desse vizinho. Excessos e capacidades residuais são atômicos
+//     (soma por compare-and-swap), sem travas; o gap vem da reetiquetagem global entre
+//     rodadas.
+
+#include <vector>
+#include <queue>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include "paralelo.hpp"
+
+// Reetiquetagem global a cada FLUXO_ALFA * V + E de trabalho de reetiquetagem
+const int FLUXO_ALFA = 6;
+
+struct ArcoCapacidade {
+    int origem;
+    int destino;
+    double capacidade;
+};
+
+struct ResultadoFluxo {
+    double valor = 0.0;
+    int fases = 0;                      // Dinic
+    long long aumentos = 0;
+    long long empurroes = 0;            // push-relabel
+    long long reetiquetagens = 0;
+    int reetiquetagensGlobais = 0;
+    int rodadas = 0;                    // push-relabel paralelo
+    unsigned threads = 1;
+    double segundos = 0.0;
+};
+
+namespace fluxo_detalhe {
+
+// atomic<double> não tem fetch_add antes do C++20. seq_cst, não acq_rel: no push-relabel
+// paralelo, "soma o excesso de w, depois lê naFila[w]" de quem empurra e "zera naFila[u],
+// depois lê o excesso de u" do dono formam um Dekker, e só a ordem total seq_cst impede
+// que as duas threads leiam o valor antigo (w com excesso e fora da fila para sempre)
+inline double somar(std::atomic<double>& x, double d) {
+    double antigo = x.load(std::memory_order_relaxed);
+    while (!x.compare_exchange_weak(antigo, antigo + d, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    }
+    return antigo;
+}
+
+} // namespace fluxo_detalhe
+
+class RedeResidual {
+private:
+    int numVertices;
+    std::vector<int> inicio;        // arcos residuais de v: [inicio[v], inicio[v + 1])
+    std::vector<int> destino;
+    std::vector<int> reverso;
+    std::vector<double> residual;
+
+    std::vector<int> nivel;
+    std::vector<int> atual;
+
+    bool calcularNiveis(int s, int t) {
+        std::fill(nivel.begin(), nivel.end(), -1);
+        std::queue<int> fila;
+        nivel[s] = 0;
+        fila.push(s);
+        while (!fila.empty()) {
+            int u = fila.front();
+            fila.pop();
+            for (int e = inicio[u]; e < inicio[u + 1]; e++) {
+                int v = destino[e];
+                if (residual[e] > 0 && nivel[v] < 0) {
+                    nivel[v] = nivel[u] + 1;
+                    fila.push(v);
+                }
+            }
+        }
+        return nivel[t] >= 0;
+    }
+
+    // Fluxo bloqueante da fase; caminho guarda os arcos de s até o vértice corrente
+    double fluxoBloqueante(int s, int t, long long& aumentos) {
+        double total = 0.0;
+        std::vector<int> caminho;
+        int v = s;
+        while (true) {
+            if (v == t) {
+                double gargalo = std::numeric_limits<double>::infinity();
+                for (int e : caminho) gargalo = std::min(gargalo, residual[e]);
+                for (int e : caminho) {
+                    residual[e] -= gargalo;
+                    residual[reverso[e]] += gargalo;
+                }
+                total += gargalo;
+                aumentos++;
+                // Recomeça do início do primeiro arco saturado
+                std::size_t corte = 0;
+                while (residual[caminho[corte]] > 0) corte++;
+                caminho.resize(corte);
+                v = corte == 0 ? s : destino[caminho[corte - 1]];
+                continue;
+            }
+            int& e = atual[v];
+            while (e < inicio[v + 1] && !(residual[e] > 0 && nivel[destino[e]] == nivel[v] + 1)) e++;
+            if (e < inicio[v + 1]) {
+                caminho.push_back(e);
+                v = destino[e];
+                continue;
+            }
+            // Beco sem saída: v sai do grafo de níveis e o arco que levou a ele é pulado
+            if (v == s) break;
+            nivel[v] = -1;
+            caminho.pop_back();
+            v = caminho.empty() ? s : destino[caminho.back()];
+            atual[v]++;
+        }
+        return total;
+    }
+
+    // Alturas exatas: distância residual até t (BFS pelos arcos reversos); s e os que não
+    // chegam a t ficam com V. residualDe(e) lê a capacidade residual do arco e.
+    template <typename F>
+    void alturasExatas(int s, int t, F residualDe, std::vector<int>& altura) const {
+        altura.assign(numVertices, numVertices);
+        std::vector<int> fila = {t};
+        altura[t] = 0;
+        for (std::size_t i = 0; i < fila.size(); i++) {
+            int v = fila[i];
+            for (int e = inicio[v]; e < inicio[v + 1]; e++) {
+                int u = destino[e];
+                if (u != s && altura[u] == numVertices && residualDe(reverso[e]) > 0) {
+                    altura[u] = altura[v] + 1;
+                    fila.push_back(u);
+                }
+            }
+        }
+    }
+
+public:
+    RedeResidual(int numVertices, const std::vector<ArcoCapacidade>& arcos)
+        : numVertices(numVertices), inicio(numVertices + 1, 0), nivel(numVertices), atual(numVertices) {
+        // Laços não levam fluxo a lugar nenhum
+        for (const auto& a : arcos) {
+            if (a.origem == a.destino) continue;
+            inicio[a.origem + 1]++;
+            inicio[a.destino + 1]++;
+        }
+        for (int v = 0; v < numVertices; v++) inicio[v + 1] += inicio[v];
+        destino.resize(inicio[numVertices]);
+        reverso.resize(inicio[numVertices]);
+        residual.resize(inicio[numVertices]);
+        std::vector<int> proximo(inicio.begin(), inicio.end() - 1);
+        for (const auto& a : arcos) {
+            if (a.origem == a.destino) continue;
+            int ida = proximo[a.origem]++;
+            int volta = proximo[a.destino]++;
+            destino[ida] = a.destino;
+            residual[ida] = a.capacidade;
+            reverso[ida] = volta;
+            destino[volta] = a.origem;
+            residual[volta] = 0.0;
+            reverso[volta] = ida;
+        }
+    }
+
+    int getNumVertices() const { return numVertices; }
+
+    // Fluxo máximo de s para t; as capacidades residuais ficam com o fluxo final
+    ResultadoFluxo dinic(int s, int t) {
+        auto comeco = std::chrono::steady_clock::now();
+        ResultadoFluxo r;
+        if (s != t) {
+            while (calcularNiveis(s, t)) {
+                r.fases++;
+                std::copy(inicio.begin(), inicio.end() - 1, atual.begin());
+                r.valor += fluxoBloqueante(s, t, r.aumentos);
+            }
+        }
+        r.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - comeco).count();
+        return r;
+    }
+
+    // Push-relabel sequencial (maior altura, FIFO, reetiquetagem global e gap)
+    ResultadoFluxo pushRelabel(int s, int t) {
+        auto comeco = std::chrono::steady_clock::now();
+        ResultadoFluxo r;
+        int n = numVertices;
+        if (s == t) return r;
+
+        std::vector<double> excesso(n, 0.0);
+        std::vector<int> altura;
+        // Todos os vértices de cada altura < n em listas duplamente ligadas (para o gap) e
+        // os ativos de cada altura em filas FIFO ligadas
+        std::vector<int> proximo(n), anterior(n), cabeca(n);
+        std::vector<int> proximoAtivo(n), primeiroAtivo(n), ultimoAtivo(n);
+        int maiorAltura = -1;
+        int maiorAtivo = -1;
+
+        auto inserir = [&](int v) {
+            int h = altura[v];
+            proximo[v] = cabeca[h];
+            anterior[v] = -1;
+            if (cabeca[h] >= 0) anterior[cabeca[h]] = v;
+            cabeca[h] = v;
+            maiorAltura = std::max(maiorAltura, h);
+        };
+        auto retirar = [&](int v) {
+            int h = altura[v];
+            if (anterior[v] >= 0) {
+                proximo[anterior[v]] = proximo[v];
+            } else {
+                cabeca[h] = proximo[v];
+            }
+            if (proximo[v] >= 0) anterior[proximo[v]] = anterior[v];
+        };
+        auto ativar = [&](int v) {
+            int h = altura[v];
+            proximoAtivo[v] = -1;
+            if (primeiroAtivo[h] < 0) {
+                primeiroAtivo[h] = v;
+            } else {
+                proximoAtivo[ultimoAtivo[h]] = v;
+            }
+            ultimoAtivo[h] = v;
+            maiorAtivo = std::max(maiorAtivo, h);
+        };
+        auto reetiquetarTudo = [&]() {
+            r.reetiquetagensGlobais++;
+            alturasExatas(s, t, [&](int e) { return residual[e]; }, altura);
+            std::fill(cabeca.begin(), cabeca.end(), -1);
+            std::fill(primeiroAtivo.begin(), primeiroAtivo.end(), -1);
+            maiorAltura = maiorAtivo = -1;
+            for (int v = 0; v < n; v++) {
+                atual[v] = inicio[v];
+                if (altura[v] >= n) continue;
+                inserir(v);
+                if (v != t && excesso[v] > 0) ativar(v);
+            }
+        };
+
+        // Pré-fluxo inicial: arcos de s saturados
+        for (int e = inicio[s]; e < inicio[s + 1]; e++) {
+            double d = residual[e];
+            if (!(d > 0)) continue;
+            residual[e] = 0.0;
+            residual[reverso[e]] += d;
+            excesso[destino[e]] += d;
+            excesso[s] -= d;
+        }
+        reetiquetarTudo();
+
+        long long limite = static_cast<long long>(FLUXO_ALFA) * n + static_cast<long long>(destino.size());
+        long long trabalho = 0;
+        while (maiorAtivo >= 0) {
+            int v = primeiroAtivo[maiorAtivo];
+            if (v < 0) {
+                maiorAtivo--;
+                continue;
+            }
+            primeiroAtivo[maiorAtivo] = proximoAtivo[v];
+
+            // Descarregar v
+            int h = altura[v];
+            while (excesso[v] > 0) {
+                int& e = atual[v];
+                if (e < inicio[v + 1]) {
+                    int w = destino[e];
+                    if (residual[e] > 0 && altura[w] == h - 1) {
+                        double d = std::min(excesso[v], residual[e]);
+                        bool inativo = !(excesso[w] > 0);
+                        residual[e] -= d;
+                        residual[reverso[e]] += d;
+                        excesso[v] -= d;
+                        excesso[w] += d;
+                        r.empurroes++;
+                        if (inativo && w != s && w != t) ativar(w);
+                        if (residual[e] > 0) continue;
+                    }
+                    e++;
+                    continue;
+                }
+
+                // Sem arco admissível: reetiquetar
+                r.reetiquetagens++;
+                trabalho += inicio[v + 1] - inicio[v] + 12;
+                if (cabeca[h] == v && proximo[v] < 0) {
+                    // Gap: v era o último de altura h; ninguém de h para cima alcança t
+                    for (int k = h; k <= maiorAltura; k++) {
+                        for (int x = cabeca[k]; x >= 0; x = proximo[x]) altura[x] = n;
+                        cabeca[k] = -1;
+                        primeiroAtivo[k] = -1;
+                    }
+                    maiorAltura = h - 1;
+                    maiorAtivo = std::min(maiorAtivo, h - 1);
+                    break;
+                }
+                int nova = n;
+                for (int a = inicio[v]; a < inicio[v + 1]; a++) {
+                    if (residual[a] > 0) nova = std::min(nova, altura[destino[a]] + 1);
+                }
+                retirar(v);
+                altura[v] = nova;
+                if (nova >= n) break;
+                h = nova;
+                inserir(v);
+                e = inicio[v];
+            }
+
+            if (trabalho > limite) {
+                reetiquetarTudo();
+                trabalho = 0;
+            }
+        }
+
+        r.valor = excesso[t];
+        r.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - comeco).count();
+        return r;
+    }
+
+    // Push-relabel paralelo sem travas (Hong). numThreads = 0 usa todos os núcleos.
+    ResultadoFluxo pushRelabelParalelo(int s, int t, unsigned numThreads = 0) {
+        auto comeco = std::chrono::steady_clock::now();
+        ResultadoFluxo r;
+        r.threads = threadsEfetivas(numThreads);
+        unsigned threads = r.threads;
+        int n = numVertices;
+        if (s == t) return r;
+
+        std::size_t numArcos = destino.size();
+        std::unique_ptr<std::atomic<double>[]> res(new std::atomic<double>[numArcos]);
+        std::unique_ptr<std::atomic<double>[]> excesso(new std::atomic<double>[n]);
+        std::unique_ptr<std::atomic<int>[]> altura(new std::atomic<int>[n]);
+        std::unique_ptr<std::atomic<char>[]> naFila(new std::atomic<char>[n]);
+        for (std::size_t e = 0; e < numArcos; e++) res[e].store(residual[e], std::memory_order_relaxed);
+        for (int v = 0; v < n; v++) {
+            excesso[v].store(0.0, std::memory_order_relaxed);
+            naFila[v].store(0, std::memory_order_relaxed);
+        }
+        for (int e = inicio[s]; e < inicio[s + 1]; e++) {
+            double d = res[e].load(std::memory_order_relaxed);
+            if (!(d > 0)) continue;
+            res[e].store(0.0, std::memory_order_relaxed);
+            fluxo_detalhe::somar(res[reverso[e]], d);
+            fluxo_detalhe::somar(excesso[destino[e]], d);
+            fluxo_detalhe::somar(excesso[s], -d);
+        }
+
+        // Entre rodadas: alturas exatas e fronteira com todos os ativos
+        std::vector<int> fronteira;
+        std::vector<int> exatas;
+        auto reetiquetarTudo = [&]() {
+            r.reetiquetagensGlobais++;
+            alturasExatas(s, t, [&](int e) { return res[e].load(std::memory_order_relaxed); }, exatas);
+            fronteira.clear();
+            for (int v = 0; v < n; v++) {
+                altura[v].store(exatas[v], std::memory_order_relaxed);
+                bool ativo = v != s && v != t && exatas[v] < n && excesso[v].load(std::memory_order_relaxed) > 0;
+                naFila[v].store(ativo, std::memory_order_relaxed);
+                if (ativo) fronteira.push_back(v);
+            }
+        };
+        reetiquetarTudo();
+
+        long long limite = static_cast<long long>(FLUXO_ALFA) * n + static_cast<long long>(numArcos);
+        long long trabalho = 0;
+        std::vector<std::vector<int>> proximos(threads);
+        std::vector<long long> empurroes(threads, 0), reetiquetagens(threads, 0), trabalhos(threads, 0);
+        while (!fronteira.empty()) {
+            r.rodadas++;
+            std::size_t tamanho = fronteira.size();
+            unsigned usadas = tamanho < 64 ? 1 : threads;
+            emParalelo(usadas, [&](unsigned id) {
+                for (std::size_t i = tamanho * id / usadas; i < tamanho * (id + 1) / usadas; i++) {
+                    int u = fronteira[i];
+                    // Limpa antes de olhar o excesso: um empurrão depois disso põe u de volta.
+                    // Par do somar(excesso[w]) + exchange(naFila[w]) abaixo; os quatro são seq_cst
+                    naFila[u].store(0, std::memory_order_seq_cst);
+                    while (excesso[u].load(std::memory_order_seq_cst) > 0 &&
+                           altura[u].load(std::memory_order_relaxed) < n) {
+                        int hu = altura[u].load(std::memory_order_relaxed);
+                        int melhor = -1;
+                        int menor = n;
+                        for (int e = inicio[u]; e < inicio[u + 1]; e++) {
+                            if (!(res[e].load(std::memory_order_acquire) > 0)) continue;
+                            int hw = altura[destino[e]].load(std::memory_order_relaxed);
+                            if (melhor < 0 || hw < menor) {
+                                menor = hw;
+                                melhor = e;
+                            }
+                        }
+                        if (melhor < 0) {
+                            altura[u].store(n, std::memory_order_relaxed);
+                            break;
+                        }
+                        if (hu > menor) {
+                            // Só o dono de u tira de excesso[u] e de res[melhor]: d cabe nos dois
+                            int w = destino[melhor];
+                            double d = std::min(excesso[u].load(std::memory_order_acquire),
+                                                res[melhor].load(std::memory_order_acquire));
+                            fluxo_detalhe::somar(res[melhor], -d);
+                            fluxo_detalhe::somar(res[reverso[melhor]], d);
+                            fluxo_detalhe::somar(excesso[u], -d);
+                            fluxo_detalhe::somar(excesso[w], d);
+                            empurroes[id]++;
+                            if (w != s && w != t && !naFila[w].exchange(1, std::memory_order_seq_cst)) {
+                                proximos[id].push_back(w);
+                            }
+                        } else {
+                            altura[u].store(std::min(menor + 1, n), std::memory_order_relaxed);
+                            reetiquetagens[id]++;
+                            trabalhos[id] += inicio[u + 1] - inicio[u] + 12;
+                        }
+                    }
+                }
+            });
+
+            fronteira.clear();
+            for (unsigned id = 0; id < threads; id++) {
+                for (int w : proximos[id]) {
+                    if (altura[w].load(std::memory_order_relaxed) < n) fronteira.push_back(w);
+                }
+                proximos[id].clear();
+                trabalho += trabalhos[id];
+                trabalhos[id] = 0;
+            }
+            if (trabalho > limite) {
+                reetiquetarTudo();
+                trabalho = 0;
+            }
+        }
+
+        for (unsigned id = 0; id < threads; id++) {
+            r.empurroes += empurroes[id];
+            r.reetiquetagens += reetiquetagens[id];
+        }
+        for (std::size_t e = 0; e < numArcos; e++) residual[e] = res[e].load(std::memory_order_relaxed);
+        r.valor = excesso[t].load();
+        r.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - comeco).count();
+        return r;
+    }
+};
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef SNAPSHOT_GBIN_HPP
+#define SNAPSHOT_GBIN_HPP
+
+// Formato binário .gbin: instantâneo de um grafo já carregado, em layout CSR,
+// pronto para ser mapeado em memória somente-leitura, sem cópia nem conversão; vários
+// processos que abrem o mesmo .gbin compartilham a mesma cópia no page cache.
+//
+// Na abertura são validados: o cabeçalho (versão, tamanho do arquivo, seções dentro do
+// arquivo e alinhadas); offsets e rotulosIdx não decrescentes e dentro das suas seções
+// (O(n)); e todo destino em 1..n (O(m), uma varredura sequencial de 4 bytes por
+// entrada). Um arquivo corrompido é recusado em vez de levar a acessos fora dos arrays.
+//
+// Layout (seções alinhadas em 8 bytes, inteiros na ordem de bytes nativa):
+//   CabecalhoGbin
+//   uint64 offsets[n + 2]     vizinhos de v em [offsets[v], offsets[v+1]), v = 0..n
+//   int32  destinos[m]        índices do .net (1..n); a linha 0 fica sempre vazia
+//   double pesos[m]
+//   uint64 rotulosIdx[n + 2]  rótulo de v em rotulosDados[rotulosIdx[v] .. rotulosIdx[v+1])
+//   char   rotulosDados[]
+//
+// Grafos não dirigidos guardam as duas direções de cada aresta.
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "leitor_pajek.hpp"
+
+const std::uint32_t GBIN_VERSAO = 1;
+
+// Bits de CabecalhoGbin::flags
+const std::uint32_t GBIN_DIRIGIDO = 1;
+const std::uint32_t GBIN_PONDERADO = 2;
+const std::uint32_t GBIN_LINHAS_ORDENADAS = 4; // cada linha em ordem crescente de destino, sem repetições
+
+struct CabecalhoGbin {
+    char magica[4];
+    std::uint32_t versao;
+    std::uint32_t flags;
+    std::uint32_t reservado;
+    std::uint64_t numVertices;
+    std::uint64_t numEntradas;     // posições ocupadas no CSR
+    std::uint64_t numArestas;      // arestas como contadas pelo Grafo que gravou
+    std::uint64_t posOffsets;
+    std::uint64_t posDestinos;
+    std::uint64_t posPesos;
+    std::uint64_t posRotulosIdx;
+    std::uint64_t posRotulosDados;
+    std::uint64_t tamanhoArquivo;
+};
+
+// Verifica pelos 4 primeiros bytes se o arquivo é um .gbin
+inline bool ehArquivoGbin(const std::string& caminho) {
+    std::ifstream arquivo(caminho, std::ios::binary);
+    char magica[4] = {0, 0, 0, 0};
+    arquivo.read(magica, 4);
+    return arquivo.gcount() == 4 && std::memcmp(magica, "GBIN", 4) == 0;
+}
+
+namespace gbin_detalhe {
+
+inline std::uint64_t alinhar(std::uint64_t pos) {
+    return (pos + 7) & ~std::uint64_t(7);
+}
+
+inline void completar(std::ofstream& saida, std::uint64_t& pos, std::uint64_t alvo) {
+    static const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    saida.write(zeros, alvo - pos);
+    pos = alvo;
+}
+
+} // namespace gbin_detalhe
+
+// Grava um .gbin. offsets tem n + 2 posições; rotulos[v] vale para v = 1..n (rotulos[0] é ignorado).
+inline bool gravarGbin(const std::string& caminho, std::uint32_t flags, std::uint64_t numVertices,
+                       std::uint64_t numArestas, const std::uint64_t* offsets,
+                       const std::int32_t* destinos, const double* pesos,
+                       const std::vector<std::string>& rotulos) {
+    using gbin_detalhe::alinhar;
+    using gbin_detalhe::completar;
+
+    std::ofstream saida(caminho, std::ios::binary | std::ios::trunc);
+    if (!saida.is_open()) {
+        std::cerr << "Erro ao criar arquivo: " << caminho << std::endl;
+        return false;
+    }
+
+    std::uint64_t n = numVertices;
+    std::uint64_t m = offsets[n + 1];
+
+    std::vector<std::uint64_t> rotulosIdx(n + 2, 0);
+    for (std::uint64_t v = 1; v <= n; v++) {
+        std::uint64_t tam = v < rotulos.size() ? rotulos[v].size() : 0;
+        rotulosIdx[v + 1] = rotulosIdx[v] + tam;
+    }
+
+    CabecalhoGbin cab;
+    std::memset(&cab, 0, sizeof(cab));
+    std::memcpy(cab.magica, "GBIN", 4);
+    cab.versao = GBIN_VERSAO;
+    cab.flags = flags;
+    cab.numVertices = n;
+    cab.numEntradas = m;
+    cab.numArestas = numArestas;
+    cab.posOffsets = alinhar(sizeof(CabecalhoGbin));
+    cab.posDestinos = alinhar(cab.posOffsets + (n + 2) * sizeof(std::uint64_t));
+    cab.posPesos = alinhar(cab.posDestinos + m * sizeof(std::int32_t));
+    cab.posRotulosIdx = alinhar(cab.posPesos + m * sizeof(double));
+    cab.posRotulosDados = alinhar(cab.posRotulosIdx + (n + 2) * sizeof(std::uint64_t));
+    cab.tamanhoArquivo = alinhar(cab.posRotulosDados + rotulosIdx[n + 1]);
+
+    std::uint64_t pos = 0;
+    saida.write(reinterpret_cast<const char*>(&cab), sizeof(cab));
+    pos += sizeof(cab);
+    completar(saida, pos, cab.posOffsets);
+    saida.write(reinterpret_cast<const char*>(offsets), (n + 2) * sizeof(std::uint64_t));
+    pos += (n + 2) * sizeof(std::uint64_t);
+    completar(saida, pos, cab.posDestinos);
+    saida.write(reinterpret_cast<const char*>(destinos), m * sizeof(std::int32_t));
+    pos += m * sizeof(std::int32_t);
+    completar(saida, pos, cab.posPesos);
+    saida.write(reinterpret_cast<const char*>(pesos), m * sizeof(double));
+    pos += m * sizeof(double);
+    completar(saida, pos, cab.posRotulosIdx);
+    saida.write(reinterpret_cast<const char*>(rotulosIdx.data()), (n + 2) * sizeof(std::uint64_t));
+    pos += (n + 2) * sizeof(std::uint64_t);
+    completar(saida, pos, cab.posRotulosDados);
+    for (std::uint64_t v = 1; v < rotulos.size() && v <= n; v++) {
+        saida.write(rotulos[v].data(), rotulos[v].size());
+    }
+    pos += rotulosIdx[n + 1];
+    completar(saida, pos, cab.tamanhoArquivo);
+
+    return static_cast<bool>(saida);
+}
+
+// .gbin aberto e mapeado somente-leitura. Os ponteiros valem enquanto o objeto existir.
+class SnapshotGbin {
+private:
+    ArquivoMapeado arquivo;
+    const CabecalhoGbin* cab;
+    bool ok;
+
+    template <typename T>
+    const T* secao(std::uint64_t pos) const {
+        return reinterpret_cast<const T*>(arquivo.inicio() + pos);
+    }
+
+public:
+    explicit SnapshotGbin(const std::string& caminho) : arquivo(caminho, false), cab(nullptr), ok(false) {
+        if (!arquivo.aberto() || arquivo.bytes() < sizeof(CabecalhoGbin)) return;
+        cab = reinterpret_cast<const CabecalhoGbin*>(arquivo.inicio());
+        if (std::memcmp(cab->magica, "GBIN", 4) != 0 || cab->versao != GBIN_VERSAO) return;
+        if (cab->tamanhoArquivo != arquivo.bytes()) return;
+
+        std::uint64_t n = cab->numVertices;
+        std::uint64_t m = cab->numEntradas;
+        std::uint64_t tamanho = cab->tamanhoArquivo;
+        // Antes de multiplicar ou somar: nada disso passa do tamanho do arquivo (sem estouro)
+        if (n > tamanho / sizeof(std::uint64_t) || m > tamanho / sizeof(std::int32_t) ||
+            n >= static_cast<std::uint64_t>(std::numeric_limits<std::int32_t>::max())) return;
+        if (cab->posOffsets > tamanho || cab->posDestinos > tamanho || cab->posPesos > tamanho ||
+            cab->posRotulosIdx > tamanho || cab->posRotulosDados > tamanho) return;
+        bool limitesOk = cab->posOffsets + (n + 2) * sizeof(std::uint64_t) <= cab->posDestinos &&
+                         cab->posDestinos + m * sizeof(std::int32_t) <= cab->posPesos &&
+                         cab->posPesos + m * sizeof(double) <= cab->posRotulosIdx &&
+                         cab->posRotulosIdx + (n + 2) * sizeof(std::uint64_t) <= cab->posRotulosDados &&
+                         cab->posRotulosDados <= cab->tamanhoArquivo;
+        bool alinhado = (cab->posOffsets | cab->posDestinos | cab->posPesos | cab->posRotulosIdx) % 8 == 0;
+        if (!limitesOk || !alinhado) return;
+
+        // Linhas: offsets não decrescentes até m; rótulos: índices não decrescentes até o
+        // fim dos dados
+        const std::uint64_t* o = offsets();
+        const std::uint64_t* idx = secao<std::uint64_t>(cab->posRotulosIdx);
+        if (o[n + 1] != m || idx[n + 1] > tamanho - cab->posRotulosDados) return;
+        for (std::uint64_t v = 0; v <= n; v++) {
+            if (o[v] > o[v + 1] || idx[v] > idx[v + 1]) return;
+        }
+
+        // Destinos: índices do .net, 1..n (sem desvio no laço, para vetorizar)
+        const std::int32_t* d = destinos();
+        std::uint32_t foraDoIntervalo = 0;
+        for (std::uint64_t i = 0; i < m; i++) {
+            foraDoIntervalo |= static_cast<std::uint32_t>(d[i] - 1) >= n;
+        }
+        if (foraDoIntervalo) return;
+        ok = true;
+    }
+
+    bool valido() const { return ok; }
+    bool dirigido() const { return cab->flags & GBIN_DIRIGIDO; }
+    bool ponderado() const { return cab->flags & GBIN_PONDERADO; }
+    bool linhasOrdenadas() const { return cab->flags & GBIN_LINHAS_ORDENADAS; }
+    int numVertices() const { return static_cast<int>(cab->numVertices); }
+    std::uint64_t numEntradas() const { return cab->numEntradas; }
+    std::uint64_t numArestas() const { return cab->numArestas; }
+
+    const std::uint64_t* offsets() const { return secao<std::uint64_t>(cab->posOffsets); }
+    const std::int32_t* destinos() const { return secao<std::int32_t>(cab->posDestinos); }
+    const double* pesos() const { return secao<double>(cab->posPesos); }
+
+    std::string rotulo(int v) const {
+        if (v < 0 || static_cast<std::uint64_t>(v) > cab->numVertices) return "";
+        const std::uint64_t* idx = secao<std::uint64_t>(cab->posRotulosIdx);
+        const char* dados = secao<char>(cab->posRotulosDados);
+        return std::string(dados + idx[v], dados + idx[v + 1]);
+    }
+};
+
+#endif
@@ -0,0 +1,98 @@
+#include <iostream>
+#include <random>
+#include "grafo.hpp"
+#include "paralelo.hpp"
+
+using namespace std;
+
+// Confere o valor do fluxo máximo de pushRelabel() e de pushRelabelParalelo() (1 a 8
+// threads) contra o de dinic() em redes aleatórias. Capacidades inteiras: as somas em
+// double são exatas e os valores têm de ser iguais, sem tolerância.
+
+// Três formas, com s = 0 e t = n - 1: arcos uniformes; camadas (muitos vértices ativos ao
+// mesmo tempo); e grade de segmentação, com s e t ligados a todos os pixels
+Grafo redeAleatoria(mt19937& gerador, int forma) {
+    uniform_int_distribution<int> capacidade(1, 100);
+    if (forma == 2) {
+        int lado = uniform_int_distribution<int>(10, 40)(gerador);
+        int n = lado * lado + 2;
+        Grafo g(n, true, true);
+        for (int i = 0; i < lado; i++) {
+            for (int j = 0; j < lado; j++) {
+                int v = 1 + i * lado + j;
+                g.adicionarAresta(0, v, capacidade(gerador));
+                g.adicionarAresta(v, n - 1, capacidade(gerador));
+                if (j + 1 < lado) {
+                    g.adicionarAresta(v, v + 1, capacidade(gerador));
+                    g.adicionarAresta(v + 1, v, capacidade(gerador));
+                }
+                if (i + 1 < lado) {
+                    g.adicionarAresta(v, v + lado, capacidade(gerador));
+                    g.adicionarAresta(v + lado, v, capacidade(gerador));
+                }
+            }
+        }
+        return g;
+    }
+    if (forma == 1) {
+        int camadas = uniform_int_distribution<int>(3, 12)(gerador);
+        int largura = uniform_int_distribution<int>(20, 150)(gerador);
+        int n = camadas * largura + 2;
+        Grafo g(n, true, true);
+        uniform_int_distribution<int> posicao(0, largura - 1);
+        for (int j = 0; j < largura; j++) {
+            g.adicionarAresta(0, 1 + j, capacidade(gerador));
+            g.adicionarAresta(1 + (camadas - 1) * largura + j, n - 1, capacidade(gerador));
+        }
+        for (int c = 0; c + 1 < camadas; c++) {
+            for (int j = 0; j < largura; j++) {
+                for (int k = 0; k < 3; k++) {
+                    g.adicionarAresta(1 + c * largura + j, 1 + (c + 1) * largura + posicao(gerador),
+                                      capacidade(gerador));
+                }
+                // Arco de volta: ciclos no residual desde o início
+                if (c > 0 && gerador() % 4 == 0) {
+                    g.adicionarAresta(1 + c * largura + j, 1 + (c - 1) * largura + posicao(gerador),
+                                      capacidade(gerador));
+                }
+            }
+        }
+        return g;
+    }
+    int n = uniform_int_distribution<int>(50, 2000)(gerador);
+    int m = n * uniform_int_distribution<int>(2, 6)(gerador);
+    Grafo g(n, true, true);
+    uniform_int_distribution<int> vertice(0, n - 1);
+    for (int i = 0; i < m; i++) g.adicionarAresta(vertice(gerador), vertice(gerador), capacidade(gerador));
+    return g;
+}
+
+int main(int argc, char* argv[]) {
+    int quantidade = 90;
+    if (argc == 2 && (!lerNumero(argv[1], quantidade) || quantidade < 1)) {
+        cerr << "Usage: " << argv[0] << " [<networks>]" << endl;
+        return 1;
+    }
+
+    mt19937 gerador(2024);
+    int falhas = 0;
+    for (int i = 0; i < quantidade; i++) {
+        Grafo g = redeAleatoria(gerador, i % 3);
+        int s = 0;
+        int t = g.getNumVertices() - 1;
+        double esperado = g.dinic(s, t).valor;
+        auto conferir = [&](const char* nome, unsigned threads, double valor) {
+            if (valor == esperado) return;
+            cerr << "Mismatch: network " << i << " (shape " << i % 3 << ", n=" << g.getNumVertices() << ") "
+                 << nome << " threads=" << threads << ": " << valor << " != dinic " << esperado << endl;
+            falhas++;
+        };
+        conferir("push-relabel", 1, g.pushRelabel(s, t).valor);
+        for (unsigned threads : {1u, 2u, 4u, 8u}) {
+            conferir("push-relabel-paralelo", threads, g.pushRelabelParalelo(s, t, threads).valor);
+        }
+    }
+    if (falhas > 0) return 1;
+    cout << "max flow: " << quantidade << " networks, push-relabel equal to dinic" << endl;
+    return 0;
+}